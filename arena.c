@@ -0,0 +1,108 @@
+/*
+    Per-thread arena allocator over a static region (see arena.h).
+*/
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include "arena.h"
+
+static _Alignas(4096) unsigned char region[ARENA_REGION_BYTES];
+static CACHE_ALIGNED atomic_size_t region_used;   // bytes handed out as blocks
+static atomic_size_t region_peak;
+static atomic_uint region_generation;
+
+#define ROUND_UP(n) (((n) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+// Drops the arena's block if arena_reset_all() ran since its last use.
+static inline unsigned renew(Arena *a) {
+    unsigned generation = atomic_load_explicit(&region_generation, memory_order_acquire);
+    if (a->generation != generation) {
+        a->cursor = a->limit = NULL;
+        a->generation = generation;
+    }
+    return generation;
+}
+
+// Claims a block of at least bytes from the region: the only shared write.
+static int claim_block(Arena *a, size_t bytes) {
+    size_t size = bytes > ARENA_BLOCK_BYTES ? bytes : ARENA_BLOCK_BYTES;
+    size_t offset = atomic_fetch_add_explicit(&region_used, size, memory_order_relaxed);
+    if (size > ARENA_REGION_BYTES || offset > ARENA_REGION_BYTES - size) {
+        a->failures++;
+        return -1;
+    }
+    size_t peak = atomic_load_explicit(&region_peak, memory_order_relaxed);
+    while (offset + size > peak &&
+           !atomic_compare_exchange_weak_explicit(&region_peak, &peak, offset + size,
+                                                  memory_order_relaxed, memory_order_relaxed)) {}
+    a->cursor = region + offset;
+    a->limit = a->cursor + size;
+    a->blocks++;
+    return 0;
+}
+
+void *arena_alloc(Arena *a, size_t bytes) {
+    renew(a);
+    bytes = ROUND_UP(bytes);
+    if (!a->cursor || (size_t)(a->limit - a->cursor) < bytes) {
+        if (claim_block(a, bytes) < 0) return NULL;   // the rest of the old block is dropped
+    }
+    void *p = a->cursor;
+    a->cursor += bytes;
+    a->allocs++;
+    return p;
+}
+
+void arena_pool_init(ArenaPool *p, Arena *a, size_t size) {
+    p->arena = a;
+    p->size = ROUND_UP(size < sizeof(ArenaFreeNode) ? sizeof(ArenaFreeNode) : size);
+    p->free_list = NULL;
+    p->generation = renew(a);
+}
+
+void *arena_pool_alloc(ArenaPool *p) {
+    Arena *a = p->arena;
+    unsigned generation = renew(a);
+    if (p->generation != generation) {
+        p->free_list = NULL;   // its nodes were in blocks released by the reset
+        p->generation = generation;
+    }
+    a->node_allocs++;
+    if (p->free_list) {
+        ArenaFreeNode *node = p->free_list;
+        p->free_list = node->next;
+        a->node_reused++;
+        return node;
+    }
+    return arena_alloc(a, p->size);
+}
+
+void arena_pool_free(ArenaPool *p, void *node) {
+    ArenaFreeNode *n = node;
+    n->next = p->free_list;
+    p->free_list = n;
+}
+
+void arena_reset_all(void) {
+    atomic_store_explicit(&region_used, 0, memory_order_relaxed);
+    atomic_fetch_add_explicit(&region_generation, 1, memory_order_release);
+}
+
+void arena_reset_stats(Arena *arenas, int count) {
+    atomic_store_explicit(&region_peak, 0, memory_order_relaxed);
+    for (int i = 0; i < count; i++)
+        arenas[i].allocs = arenas[i].node_allocs = arenas[i].node_reused =
+            arenas[i].blocks = arenas[i].failures = 0;
+}
+
+ArenaStats arena_stats(const Arena *arenas, int count) {
+    ArenaStats s = { atomic_load(&region_peak), 0, 0, 0, 0, 0 };
+    for (int i = 0; i < count; i++) {
+        s.allocs += arenas[i].allocs;
+        s.node_allocs += arenas[i].node_allocs;
+        s.node_reused += arenas[i].node_reused;
+        s.blocks += arenas[i].blocks;
+        s.failures += arenas[i].failures;
+    }
+    return s;
+}
@@ -0,0 +1,70 @@
+/*
+    Per-thread arena allocator for search nodes and candidate schedules.
+
+    All memory comes from one static region (no malloc, in line with the
+    solvers' static-array rule). Each worker owns an Arena and bump-allocates
+    from blocks of ARENA_BLOCK_BYTES it claims from the region with a single
+    atomic add, so the hot path never takes a lock and only block claims
+    touch shared state.
+
+    Fixed-size objects (B&B nodes, candidate schedules) go through an
+    ArenaPool: a per-thread free list in front of the arena. A freed node is
+    reused by the next allocation of the same pool; nodes are freed by the
+    worker that owns the pool.
+
+    arena_reset_all() releases everything at once (between repetitions of
+    measure_execution()): it bumps a generation number, and every arena and
+    pool drops its block and free list the next time its owner uses it, so
+    the reset never touches other workers' state. It must not run while a
+    worker is allocating. arena_reset_stats() zeroes the counters and the
+    high-water mark, so each repetition reports its own figures.
+
+    The region size can be changed at build time: -DARENA_REGION_BYTES=...
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include "cache_layout.h"
+
+#ifndef ARENA_REGION_BYTES
+#define ARENA_REGION_BYTES ((size_t)64 << 20)   // untouched pages cost nothing
+#endif
+#define ARENA_BLOCK_BYTES  ((size_t)64 << 10)   // claimed from the region at a time
+#define ARENA_ALIGN        16
+
+// One per worker, on its own cache line.
+typedef struct {
+    CACHE_ALIGNED unsigned char *cursor;
+    unsigned char *limit;
+    unsigned generation;
+    // statistics (kept across arena_reset_all, zeroed by arena_reset_stats)
+    unsigned long long allocs, node_allocs, node_reused, blocks, failures;
+} Arena;
+
+typedef struct ArenaFreeNode {
+    struct ArenaFreeNode *next;
+} ArenaFreeNode;
+
+typedef struct {
+    Arena *arena;
+    size_t size;                 // rounded up to ARENA_ALIGN
+    ArenaFreeNode *free_list;
+    unsigned generation;
+} ArenaPool;
+
+typedef struct {
+    size_t peak_bytes;           // region high-water mark since arena_reset_stats
+    unsigned long long allocs, node_allocs, node_reused, blocks, failures;
+} ArenaStats;
+
+void *arena_alloc(Arena *a, size_t bytes);              // NULL when the region is exhausted
+void  arena_pool_init(ArenaPool *p, Arena *a, size_t size);
+void *arena_pool_alloc(ArenaPool *p);                   // NULL when the region is exhausted
+void  arena_pool_free(ArenaPool *p, void *node);
+void  arena_reset_all(void);
+void  arena_reset_stats(Arena *arenas, int count);   // same rule as arena_reset_all
+ArenaStats arena_stats(const Arena *arenas, int count);
+
+#endif
@@ -0,0 +1,114 @@
+/*
+    Branch trace logger (see branch_trace.h).
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "branch_trace.h"
+
+TraceConfig trace_config = { 0, 0, 1 };
+TraceRing trace_rings[TRACE_MAX_THREADS];
+
+static FILE *trace_fp = NULL;
+static pthread_t drain_thread;
+static atomic_int drain_stop;
+static unsigned char drain_buffer[TRACE_WRITE_CHUNK];
+static size_t drain_len = 0;
+
+// Moves every ready record of every ring into the write buffer. Returns records moved.
+static uint64_t drain_rings(void) {
+    uint64_t moved = 0;
+    for (int t = 0; t < TRACE_MAX_THREADS; t++) {
+        TraceRing *ring = &trace_rings[t];
+        uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        while (tail < head) {
+            uint64_t idx = tail & (TRACE_RING_RECORDS - 1);
+            uint64_t n = head - tail;
+            if (n > TRACE_RING_RECORDS - idx) n = TRACE_RING_RECORDS - idx;   // up to the wrap point
+            size_t room = (TRACE_WRITE_CHUNK - drain_len) / sizeof(TraceRecord);
+            if (room == 0) {
+                fwrite(drain_buffer, 1, drain_len, trace_fp);
+                drain_len = 0;
+                continue;
+            }
+            if (n > room) n = room;
+            memcpy(drain_buffer + drain_len, &ring->records[idx], n * sizeof(TraceRecord));
+            drain_len += n * sizeof(TraceRecord);
+            tail += n;
+            moved += n;
+            atomic_store_explicit(&ring->tail, tail, memory_order_release);
+        }
+    }
+    return moved;
+}
+
+static void *drain_main(void *arg) {
+    (void)arg;
+    const struct timespec idle = { 0, 1000000 };   // 1 ms
+    while (!atomic_load(&drain_stop)) {
+        if (drain_rings() == 0) nanosleep(&idle, NULL);
+    }
+    drain_rings();
+    if (drain_len > 0) fwrite(drain_buffer, 1, drain_len, trace_fp);
+    drain_len = 0;
+    return NULL;
+}
+
+int trace_open(const char *filename, int max_depth, uint64_t every_n) {
+    trace_fp = fopen(filename, "wb");
+    if (!trace_fp) return -1;
+
+    uint32_t record_size = sizeof(TraceRecord);
+    fwrite("JBT1", 1, 4, trace_fp);
+    fwrite(&record_size, sizeof(record_size), 1, trace_fp);
+
+    for (int t = 0; t < TRACE_MAX_THREADS; t++) {
+        atomic_store(&trace_rings[t].head, 0);
+        atomic_store(&trace_rings[t].tail, 0);
+        trace_rings[t].branch_count = 0;
+        trace_rings[t].stalls = 0;
+    }
+    trace_config.max_depth = max_depth;
+    trace_config.every_n = every_n ? every_n : 1;
+    atomic_store(&drain_stop, 0);
+    if (pthread_create(&drain_thread, NULL, drain_main, NULL) != 0) {
+        fclose(trace_fp);
+        trace_fp = NULL;
+        return -1;
+    }
+    trace_config.enabled = 1;
+    return 0;
+}
+
+// Appends a record to the caller's ring; waits for the drainer if the ring is full.
+void trace_push(int thread, const TraceRecord *rec) {
+    TraceRing *ring = &trace_rings[thread];
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&ring->tail, memory_order_acquire) >= TRACE_RING_RECORDS) {
+        ring->stalls++;
+        while (head - atomic_load_explicit(&ring->tail, memory_order_acquire) >= TRACE_RING_RECORDS)
+            sched_yield();
+    }
+    ring->records[head & (TRACE_RING_RECORDS - 1)] = *rec;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+// Stops the drainer after it has written every pending record.
+void trace_close(void) {
+    if (!trace_fp) return;
+    trace_config.enabled = 0;
+    atomic_store(&drain_stop, 1);
+    pthread_join(drain_thread, NULL);
+    fclose(trace_fp);
+    trace_fp = NULL;
+}
+
+uint64_t trace_stalls(void) {
+    uint64_t total = 0;
+    for (int t = 0; t < TRACE_MAX_THREADS; t++) total += trace_rings[t].stalls;
+    return total;
+}
@@ -0,0 +1,76 @@
+/*
+    Branch trace logger.
+
+    Search threads append fixed-size binary records to their own ring buffer
+    (single producer / single consumer, no locks); one background pthread
+    drains all rings into the trace file with large writes. Text rendering is
+    left to the separate decoder (mainTraceDecode.c), so the search never
+    formats strings.
+
+    Sampling keeps tracing cheap enough to leave on:
+    - max_depth: only record branches at depth <= max_depth (0 = all)
+    - every_n:   only record every Nth branch of each thread (1 = all)
+
+    File format (.trc): "JBT1", uint32 record size, then TraceRecord entries
+    in native byte order. Records of one thread appear in order; records of
+    different threads are interleaved by drain chunk.
+*/
+
+#ifndef BRANCH_TRACE_H
+#define BRANCH_TRACE_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+#define TRACE_MAX_THREADS  64
+#define TRACE_RING_RECORDS 8192          // per thread, power of two
+#define TRACE_WRITE_CHUNK  (1 << 20)     // bytes per write by the drainer
+
+typedef struct {
+    uint64_t node;             // per-thread branch number (before sampling)
+    uint16_t depth;
+    uint16_t job;
+    uint16_t op;
+    uint16_t machine;
+    int32_t  start;
+    int32_t  end;
+    int32_t  partial_makespan;
+    uint32_t thread;
+} TraceRecord;                 // 32 bytes
+
+typedef struct {
+    _Alignas(64) _Atomic uint64_t head;   // written by the search thread
+    uint64_t branch_count;                // branches seen, sampled or not
+    uint64_t stalls;
+    _Alignas(64) _Atomic uint64_t tail;   // written by the drainer
+    _Alignas(64) TraceRecord records[TRACE_RING_RECORDS];
+} TraceRing;
+
+typedef struct {
+    int enabled;
+    int max_depth;
+    uint64_t every_n;
+} TraceConfig;
+
+extern TraceConfig trace_config;
+extern TraceRing trace_rings[TRACE_MAX_THREADS];
+
+int  trace_open(const char *filename, int max_depth, uint64_t every_n);
+void trace_push(int thread, const TraceRecord *rec);
+void trace_close(void);
+uint64_t trace_stalls(void);   // times a full ring made a search thread wait
+
+// Hot-path entry: filtering happens inline, only sampled records leave here.
+static inline void trace_branch(int thread, int depth, int job, int op, int machine,
+                                int start, int end, int partial_makespan) {
+    if (!trace_config.enabled) return;
+    TraceRing *ring = &trace_rings[thread];
+    uint64_t node = ++ring->branch_count;
+    if (trace_config.max_depth > 0 && depth > trace_config.max_depth) return;
+    if (trace_config.every_n > 1 && node % trace_config.every_n != 0) return;
+    TraceRecord rec = { node, (uint16_t)depth, (uint16_t)job, (uint16_t)op, (uint16_t)machine,
+                        start, end, partial_makespan, (uint32_t)thread };
+    trace_push(thread, &rec);
+}
+
+#endif
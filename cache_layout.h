@@ -0,0 +1,21 @@
+/*
+    Cache-line layout for state shared between threads.
+
+    Two variables written by different threads must not share a cache line:
+    every write invalidates the line in all other cores (false sharing),
+    even though the threads never touch the same variable. Hot shared
+    globals and per-thread slots are therefore declared CACHE_ALIGNED,
+    which starts each one on its own line; a struct whose first member is
+    CACHE_ALIGNED is also padded to a whole number of lines, so arrays of
+    it give every element separate lines.
+
+    mainFalseSharing.c measures the effect of packed against padded layouts.
+*/
+
+#ifndef CACHE_LAYOUT_H
+#define CACHE_LAYOUT_H
+
+#define CACHE_LINE    64
+#define CACHE_ALIGNED _Alignas(CACHE_LINE)
+
+#endif
@@ -0,0 +1,117 @@
+/*
+    Solver runs as child processes (see child_runner.h).
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/wait.h>
+#include "child_runner.h"
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int child_make_dir(char *dir, size_t size, const char *prefix) {
+    if ((size_t)snprintf(dir, size, "/tmp/%s.XXXXXX", prefix) >= size) return -1;
+    return mkdtemp(dir) ? 0 : -1;
+}
+
+// Work directories are flat: the solver writes files, not subdirectories.
+void child_remove_dir(const char *dir) {
+    char path[PATH_MAX];
+    DIR *d = opendir(dir);
+    if (d) {
+        for (struct dirent *e; (e = readdir(d)); ) {
+            if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+            snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+            unlink(path);
+        }
+        closedir(d);
+    }
+    rmdir(dir);
+}
+
+// Hands the complete lines in pending to on_line; returns the bytes still held.
+static size_t split_lines(char *pending, size_t held, double elapsed, const ChildHooks *hooks) {
+    char *start = pending, *nl;
+    while ((nl = memchr(start, '\n', held - (size_t)(start - pending)))) {
+        *nl = '\0';
+        if (hooks->on_line) hooks->on_line(start, elapsed, hooks->arg);
+        start = nl + 1;
+    }
+    held -= (size_t)(start - pending);
+    memmove(pending, start, held);
+    return held == CHILD_LINE - 1 ? 0 : held;   // drop an overlong line
+}
+
+/*
+    The pipe is close-on-exec, so the children of other threads never hold
+    its write end (which would keep this reader from seeing the exit). The
+    child's dup2() copies drop that flag.
+*/
+int child_run(const char *dir, char *argv[], const ChildHooks *hooks, ChildResult *result) {
+    result->status = -1;
+    result->interrupted = 0;
+    result->wall = 0.0;
+    char binary[PATH_MAX];   // resolved before the child changes directory
+    if (strchr(argv[0], '/') && realpath(argv[0], binary)) argv[0] = binary;
+    int pipe_fd[2];
+    if (pipe2(pipe_fd, O_CLOEXEC) != 0) return -1;
+
+    double t0 = now();
+    pid_t pid = fork();
+    if (pid == 0) {
+        if (chdir(dir) != 0) _exit(127);
+        dup2(pipe_fd[1], STDOUT_FILENO);
+        dup2(pipe_fd[1], STDERR_FILENO);
+        sigset_t none;   // the daemon's pool threads block SIGINT, and exec keeps the mask
+        sigemptyset(&none);
+        sigprocmask(SIG_SETMASK, &none, NULL);
+        execvp(argv[0], argv);
+        _exit(127);
+    }
+    close(pipe_fd[1]);
+    if (pid < 0) {
+        close(pipe_fd[0]);
+        return -1;
+    }
+
+    // Output is read as it comes (it may stop mid-line until the next flush),
+    // so the deadline is noticed on time
+    char pending[CHILD_LINE];
+    size_t held = 0;
+    double interrupted_at = 0.0;
+    struct pollfd pfd = { pipe_fd[0], POLLIN, 0 };
+    for (int open = 1; open; ) {
+        if (poll(&pfd, 1, CHILD_POLL_MS) > 0) {
+            ssize_t got = read(pipe_fd[0], pending + held, sizeof(pending) - 1 - held);
+            if (got <= 0) open = 0;   // the child exited
+            else held = split_lines(pending, held + (size_t)got, now() - t0, hooks);
+        }
+        double elapsed = now() - t0;
+        if (!result->interrupted && hooks->should_stop && hooks->should_stop(elapsed, hooks->arg)) {
+            kill(pid, SIGINT);
+            result->interrupted = 1;
+            interrupted_at = elapsed;
+        }
+        else if (result->interrupted && elapsed >= interrupted_at + hooks->grace_sec) {
+            kill(pid, SIGKILL);
+            interrupted_at = 1e300;
+        }
+    }
+    close(pipe_fd[0]);
+    waitpid(pid, &result->status, 0);
+    result->wall = now() - t0;
+    return 0;
+}
@@ -0,0 +1,43 @@
+/*
+    Solver runs as child processes, for the drivers that run other binaries
+    (mainSolverDaemon.c, mainTimeToTarget.c).
+
+    child_make_dir() creates a fresh work directory under /tmp; child_run()
+    forks, moves the child there (the solver's output file and V6's
+    interrupted_output.txt land in it), sends its stdout and stderr through
+    a pipe and execs argv. The parent reads the output as it comes and hands
+    every complete line to on_line with the time since the start; it asks
+    should_stop every CHILD_POLL_MS, and once that says yes the child gets
+    SIGINT (V6 then writes its best schedule so far) and SIGKILL grace_sec
+    later. child_remove_dir() deletes the work directory and its files.
+
+    Reentrant: the daemon runs one child per pool worker at a time.
+*/
+
+#ifndef CHILD_RUNNER_H
+#define CHILD_RUNNER_H
+
+#include <stddef.h>
+
+#define CHILD_LINE    4096   // longer output lines are dropped
+#define CHILD_POLL_MS 50
+
+typedef struct {
+    void (*on_line)(const char *line, double elapsed, void *arg);   // NULL: output ignored
+    int  (*should_stop)(double elapsed, void *arg);                 // NULL: never
+    void *arg;
+    double grace_sec;                                               // after SIGINT, before SIGKILL
+} ChildHooks;
+
+typedef struct {
+    int status;         // waitpid() status (the exit code is 127 when exec failed)
+    int interrupted;    // should_stop asked for SIGINT
+    double wall;        // seconds from fork to exit
+} ChildResult;
+
+int  child_make_dir(char *dir, size_t size, const char *prefix);   // /tmp/prefix.XXXXXX; -1 on failure
+void child_remove_dir(const char *dir);
+// -1 when the child could not be started; 0 when it ran (see result->status)
+int  child_run(const char *dir, char *argv[], const ChildHooks *hooks, ChildResult *result);
+
+#endif
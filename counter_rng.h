@@ -0,0 +1,53 @@
+/*
+    Counter-based random numbers.
+
+    Every value is a pure function of (seed, stream, counter): there is no
+    generator state to share or advance, so threads can draw the numbers of
+    any job/operation in any order and the result is the same as a
+    sequential run. The mixing function is the SplitMix64 finalizer applied
+    to a Weyl combination of the three inputs.
+
+    Conventions used by the generators: stream = job index, counter =
+    operation * stride + field, so instances are reproducible per seed
+    regardless of thread count.
+*/
+
+#ifndef COUNTER_RNG_H
+#define COUNTER_RNG_H
+
+#include <stdint.h>
+#include <math.h>
+
+static inline uint64_t crng_mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t crng_u64(uint64_t seed, uint64_t stream, uint64_t counter) {
+    uint64_t key = crng_mix(seed + 0x9E3779B97F4A7C15ULL * (stream + 1));
+    return crng_mix(key + 0xD1B54A32D192ED03ULL * (counter + 1));
+}
+
+// Uniform integer in [lo, hi] (lo <= hi); modulo bias is below 2^-32 for small ranges.
+static inline int crng_range(uint64_t seed, uint64_t stream, uint64_t counter, int lo, int hi) {
+    return lo + (int)(crng_u64(seed, stream, counter) % (uint64_t)(hi - lo + 1));
+}
+
+// Uniform double in [0, 1).
+static inline double crng_unit(uint64_t seed, uint64_t stream, uint64_t counter) {
+    return (crng_u64(seed, stream, counter) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Standard normal from one counter (Box-Muller). The second uniform re-mixes
+// the first draw with its own constant instead of taking another counter, so
+// callers' counter layouts (kind / op / field bits) stay collision-free.
+static inline double crng_normal(uint64_t seed, uint64_t stream, uint64_t counter) {
+    uint64_t z = crng_u64(seed, stream, counter);
+    double u1 = (z >> 11) * (1.0 / 9007199254740992.0);
+    double u2 = (crng_mix(z ^ 0x2545F4914F6CDD1DULL) >> 11) * (1.0 / 9007199254740992.0);
+    if (u1 < 1e-300) u1 = 1e-300;
+    return sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+}
+
+#endif
@@ -0,0 +1,294 @@
+/*
+    Disjunctive-graph representation with incremental longest-path updates
+    (see disjunctive_graph.h).
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "disjunctive_graph.h"
+
+#define MAX2(a, b) ((a) > (b) ? (a) : (b))
+
+// Completion time of a predecessor, 0 for the source.
+static inline int done(const DisjunctiveGraph *g, int k) {
+    return k < 0 ? 0 : g->head[k] + g->dur[k];
+}
+
+// Path length from the start of a successor to the sink, 0 for the sink.
+static inline int after(const DisjunctiveGraph *g, int k) {
+    return k < 0 ? 0 : g->dur[k] + g->tail[k];
+}
+
+static inline int recompute_head(const DisjunctiveGraph *g, int k) {
+    return MAX2(done(g, g->job_prev[k]), done(g, g->mach_prev[k]));
+}
+
+static inline int recompute_tail(const DisjunctiveGraph *g, int k) {
+    return MAX2(after(g, g->job_next[k]), after(g, g->mach_next[k]));
+}
+
+static void compute_makespan(DisjunctiveGraph *g) {
+    g->makespan = 0;
+    for (int j = 0; j < g->num_jobs; j++) {
+        int last = j * g->num_ops + g->num_ops - 1;
+        if (done(g, last) > g->makespan) g->makespan = done(g, last);
+    }
+}
+
+/*
+    Builds the graph from any feasible schedule: job arcs from the instance,
+    machine arcs from the start-time order on each machine.
+*/
+int dg_build(DisjunctiveGraph *g, ScheduleView v, MachineTimeline *tl) {
+    if (build_timeline(tl, v) != 0) return -1;
+    g->num_jobs = v.num_jobs;
+    g->num_ops = v.num_ops;
+    g->num_machines = v.num_machines;
+    g->num_nodes = v.num_jobs * v.num_ops;
+    g->stamp = 0;
+    memset(g->mark, 0, sizeof(unsigned) * g->num_nodes);
+    memset(g->dirty, 0, g->num_nodes);
+
+    for (int j = 0; j < v.num_jobs; j++) {
+        for (int i = 0; i < v.num_ops; i++) {
+            int k = j * v.num_ops + i;
+            g->dur[k] = VIEW_OP(v, j, i).duration;
+            g->machine[k] = VIEW_OP(v, j, i).machine;
+            g->job_prev[k] = i > 0 ? k - 1 : -1;
+            g->job_next[k] = i + 1 < v.num_ops ? k + 1 : -1;
+        }
+    }
+    for (int m = 0; m < v.num_machines; m++) {
+        int prev = -1;
+        g->mach_first[m] = -1;
+        for (int e = tl->machine_begin[m]; e < tl->machine_begin[m + 1]; e++) {
+            int k = tl->entries[e].job * v.num_ops + tl->entries[e].op;
+            g->mach_prev[k] = prev;
+            if (prev >= 0) g->mach_next[prev] = k;
+            else g->mach_first[m] = k;
+            prev = k;
+        }
+        if (prev >= 0) g->mach_next[prev] = -1;
+    }
+    return dg_compute(g);
+}
+
+// Full recomputation: topological order (Kahn), heads, tails. -1 on a cycle.
+int dg_compute(DisjunctiveGraph *g) {
+    int n = g->num_nodes;
+    int *indeg = g->stack;
+    for (int k = 0; k < n; k++)
+        indeg[k] = (g->job_prev[k] >= 0) + (g->mach_prev[k] >= 0);
+
+    int front = 0, back = 0;
+    for (int k = 0; k < n; k++)
+        if (indeg[k] == 0) g->topo[back++] = k;
+    while (front < back) {
+        int k = g->topo[front++];
+        int succ[2] = { g->job_next[k], g->mach_next[k] };
+        for (int s = 0; s < 2; s++)
+            if (succ[s] >= 0 && --indeg[succ[s]] == 0) g->topo[back++] = succ[s];
+    }
+    if (back != n) return -1;
+
+    for (int p = 0; p < n; p++) {
+        int k = g->topo[p];
+        g->topo_pos[k] = p;
+        g->head[k] = recompute_head(g, k);
+    }
+    for (int p = n - 1; p >= 0; p--) {
+        int k = g->topo[p];
+        g->tail[k] = recompute_tail(g, k);
+    }
+    compute_makespan(g);
+    return g->makespan;
+}
+
+/*
+    Estimated makespan after reversing the machine arc u -> v: new heads of v
+    and u and new tails of u and v from their unchanged neighbours. O(1).
+*/
+int dg_swap_estimate(const DisjunctiveGraph *g, int u, int v) {
+    int pm = g->mach_prev[u], sm = g->mach_next[v];
+    int head_v = MAX2(done(g, g->job_prev[v]), done(g, pm));
+    int head_u = MAX2(done(g, g->job_prev[u]), head_v + g->dur[v]);
+    int tail_u = MAX2(after(g, g->job_next[u]), after(g, sm));
+    int tail_v = MAX2(after(g, g->job_next[v]), tail_u + g->dur[u]);
+    return MAX2(head_v + g->dur[v] + tail_v, head_u + g->dur[u] + tail_u);
+}
+
+static int cmp_int(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
+
+// Collects nodes reachable from start within [lo, hi] topological positions.
+static int collect(DisjunctiveGraph *g, int start, int lo, int hi, int forward, int *out, int count) {
+    int top = 0;
+    g->stack[top++] = start;
+    g->mark[start] = g->stamp;
+    while (top > 0) {
+        int k = g->stack[--top];
+        out[count++] = k;
+        int next[2];
+        if (forward) { next[0] = g->job_next[k]; next[1] = g->mach_next[k]; }
+        else         { next[0] = g->job_prev[k]; next[1] = g->mach_prev[k]; }
+        for (int s = 0; s < 2; s++) {
+            int x = next[s];
+            if (x < 0 || g->mark[x] == g->stamp) continue;
+            if (g->topo_pos[x] < lo || g->topo_pos[x] > hi) continue;
+            g->mark[x] = g->stamp;
+            g->stack[top++] = x;
+        }
+    }
+    return count;
+}
+
+/*
+    Reverses the adjacent machine arc u -> v and returns the new makespan,
+    or -1 (graph unchanged) if the swap would close a cycle. Swapping two
+    operations of a critical block is always feasible. The forward search of
+    the order repair doubles as the exact cycle test.
+*/
+int dg_swap(DisjunctiveGraph *g, int u, int v) {
+    if (g->mach_next[u] != v) return -1;
+
+    int pm = g->mach_prev[u], sm = g->mach_next[v];
+    if (pm >= 0) g->mach_next[pm] = v; else g->mach_first[g->machine[u]] = v;
+    g->mach_prev[v] = pm;
+    g->mach_next[v] = u;
+    g->mach_prev[u] = v;
+    g->mach_next[u] = sm;
+    if (sm >= 0) g->mach_prev[sm] = u;
+
+    // Topological repair for the new arc v -> u (Pearce-Kelly): nodes after u
+    // that lead forward within the window, and nodes before v reaching it.
+    int lo = g->topo_pos[u], hi = g->topo_pos[v];
+    g->stamp++;
+    int nf = collect(g, u, lo, hi, 1, g->moved, 0);
+    if (g->mark[v] == g->stamp) {
+        // u still reaches v through another path: undo, the swap closes a cycle
+        if (pm >= 0) g->mach_next[pm] = u; else g->mach_first[g->machine[u]] = u;
+        g->mach_prev[u] = pm;
+        g->mach_next[u] = v;
+        g->mach_prev[v] = u;
+        g->mach_next[v] = sm;
+        if (sm >= 0) g->mach_prev[sm] = v;
+        return -1;
+    }
+    int nm = collect(g, v, lo, hi, 0, g->moved, nf);
+    for (int a = 0; a < nm; a++) g->moved_pos[a] = g->topo_pos[g->moved[a]];
+    qsort(g->moved_pos, nf, sizeof(int), cmp_int);
+    qsort(g->moved_pos + nf, nm - nf, sizeof(int), cmp_int);
+    // Backward set first, then the forward set, each in its old relative order,
+    // into the same slots.
+    int *order = g->stack;
+    for (int a = nf; a < nm; a++) order[a - nf] = g->topo[g->moved_pos[a]];
+    for (int a = 0; a < nf; a++) order[nm - nf + a] = g->topo[g->moved_pos[a]];
+    qsort(g->moved_pos, nm, sizeof(int), cmp_int);
+    for (int a = 0; a < nm; a++) {
+        g->topo[g->moved_pos[a]] = order[a];
+        g->topo_pos[order[a]] = g->moved_pos[a];
+    }
+
+    // Heads: v, u and sm lost or gained a predecessor; propagate forward.
+    int first = g->topo_pos[v];
+    g->dirty[v] = g->dirty[u] = 1;
+    if (sm >= 0) g->dirty[sm] = 1;
+    for (int p = first; p < g->num_nodes; p++) {
+        int k = g->topo[p];
+        if (!g->dirty[k]) continue;
+        g->dirty[k] = 0;
+        int h = recompute_head(g, k);
+        if (h == g->head[k]) continue;
+        g->head[k] = h;
+        if (g->job_next[k] >= 0) g->dirty[g->job_next[k]] = 1;
+        if (g->mach_next[k] >= 0) g->dirty[g->mach_next[k]] = 1;
+    }
+
+    // Tails: pm, v and u changed successors; propagate backward.
+    int last = g->topo_pos[u];
+    g->dirty[u] = g->dirty[v] = 1;
+    if (pm >= 0) g->dirty[pm] = 1;
+    for (int p = last; p >= 0; p--) {
+        int k = g->topo[p];
+        if (!g->dirty[k]) continue;
+        g->dirty[k] = 0;
+        int t = recompute_tail(g, k);
+        if (t == g->tail[k]) continue;
+        g->tail[k] = t;
+        if (g->job_prev[k] >= 0) g->dirty[g->job_prev[k]] = 1;
+        if (g->mach_prev[k] >= 0) g->dirty[g->mach_prev[k]] = 1;
+    }
+
+    compute_makespan(g);
+    return g->makespan;
+}
+
+// One critical path into g->moved: tight arcs from a critical node with
+// head 0, preferring machine arcs. Returns its length.
+static int critical_path(DisjunctiveGraph *g) {
+    int *path = g->moved, n = 0, k = -1;
+    for (int m = 0; m < g->num_nodes && k < 0; m++)
+        if (g->head[m] == 0 && g->dur[m] + g->tail[m] == g->makespan) k = m;
+    while (k >= 0) {
+        path[n++] = k;
+        int sm = g->mach_next[k], sj = g->job_next[k], next = -1;
+        if (sm >= 0 && g->head[sm] == done(g, k) && done(g, sm) + g->tail[sm] == g->makespan) next = sm;
+        else if (sj >= 0 && g->head[sj] == done(g, k) && done(g, sj) + g->tail[sj] == g->makespan) next = sj;
+        k = next;
+    }
+    return n;
+}
+
+/*
+    Candidate moves on one critical path (N5 neighbourhood): the first and
+    the last pair of every critical block, skipping the first pair of the
+    first block and the last pair of the last block, which cannot improve.
+*/
+int dg_critical_moves(DisjunctiveGraph *g, int (*moves)[2], int max_moves) {
+    int *path = g->moved, n = critical_path(g);
+    int count = 0;
+    for (int b = 0; b < n; ) {
+        int e = b;
+        while (e + 1 < n && g->mach_next[path[e]] == path[e + 1]) e++;
+        if (e > b) {
+            if (b > 0 && count < max_moves) {
+                moves[count][0] = path[b]; moves[count][1] = path[b + 1]; count++;
+            }
+            if (e < n - 1 && (e - 1 > b || b == 0) && count < max_moves) {
+                moves[count][0] = path[e - 1]; moves[count][1] = path[e]; count++;
+            }
+        }
+        b = e + 1;
+    }
+    return count;
+}
+
+/*
+    Every machine arc of one critical path (N1 neighbourhood, van Laarhoven
+    et al.): larger than N5 but connected, which annealing needs to be able
+    to reach any schedule. All of these swaps are feasible.
+*/
+int dg_critical_arcs(DisjunctiveGraph *g, int (*moves)[2], int max_moves) {
+    int *path = g->moved, n = critical_path(g);
+    int count = 0;
+    for (int p = 0; p + 1 < n && count < max_moves; p++) {
+        if (g->mach_next[path[p]] != path[p + 1]) continue;
+        moves[count][0] = path[p]; moves[count][1] = path[p + 1]; count++;
+    }
+    return count;
+}
+
+// Semi-active schedule of the graph: every operation starts at its head.
+void dg_write_schedule(const DisjunctiveGraph *g, Operation *table, int stride) {
+    for (int j = 0; j < g->num_jobs; j++) {
+        for (int i = 0; i < g->num_ops; i++) {
+            int k = j * g->num_ops + i;
+            Operation *o = &table[j * stride + i];
+            o->machine = g->machine[k];
+            o->duration = g->dur[k];
+            o->start = g->head[k];
+            o->end = g->head[k] + g->dur[k];
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/*
+    Disjunctive-graph representation of a job-shop schedule.
+
+    Node k = j * num_ops + i is operation i of job j. Conjunctive arcs follow
+    the job order (job_next/job_prev); the chosen machine sequences are the
+    disjunctive arcs (mach_next/mach_prev). For every node the graph keeps
+    - head[k]: longest path from the source to k (its start time)
+    - tail[k]: longest path from the end of k to the sink
+    so head[k] + dur[k] + tail[k] == makespan exactly on the critical path.
+
+    Moves swap two adjacent operations u -> v of one machine:
+    - dg_swap_estimate(): O(1) makespan estimate from heads/tails (exact for the
+      longest path through u or v, a lower bound of the new makespan)
+    - dg_swap(): applies the swap, repairs the topological order locally
+      (Pearce-Kelly) and re-propagates only the heads/tails that change.
+
+    Neighbourhoods on one critical path: dg_critical_moves() (N5, block ends,
+    for descents) and dg_critical_arcs() (N1, every critical machine arc,
+    for annealing).
+*/
+
+#ifndef DISJUNCTIVE_GRAPH_H
+#define DISJUNCTIVE_GRAPH_H
+
+#include "jobshop.h"
+#include "schedule_output.h"
+
+// Large (about 3 MB): declare instances static.
+typedef struct {
+    int num_jobs, num_ops, num_machines, num_nodes;
+    int makespan;
+    int dur[JSS_MAX_OPERATIONS];
+    int machine[JSS_MAX_OPERATIONS];
+    int job_next[JSS_MAX_OPERATIONS], job_prev[JSS_MAX_OPERATIONS];
+    int mach_next[JSS_MAX_OPERATIONS], mach_prev[JSS_MAX_OPERATIONS];
+    int mach_first[JSS_MAX_MACHINES];
+    int head[JSS_MAX_OPERATIONS], tail[JSS_MAX_OPERATIONS];
+    int topo[JSS_MAX_OPERATIONS], topo_pos[JSS_MAX_OPERATIONS];
+    // scratch for the incremental updates
+    unsigned stamp;
+    unsigned mark[JSS_MAX_OPERATIONS];
+    unsigned char dirty[JSS_MAX_OPERATIONS];
+    int stack[JSS_MAX_OPERATIONS];
+    int moved[JSS_MAX_OPERATIONS], moved_pos[JSS_MAX_OPERATIONS];
+} DisjunctiveGraph;
+
+int  dg_build(DisjunctiveGraph *g, ScheduleView v, MachineTimeline *tl);
+int  dg_compute(DisjunctiveGraph *g);
+int  dg_swap_estimate(const DisjunctiveGraph *g, int u, int v);
+int  dg_swap(DisjunctiveGraph *g, int u, int v);
+int  dg_critical_moves(DisjunctiveGraph *g, int (*moves)[2], int max_moves);
+int  dg_critical_arcs(DisjunctiveGraph *g, int (*moves)[2], int max_moves);
+void dg_write_schedule(const DisjunctiveGraph *g, Operation *table, int stride);
+
+#endif
@@ -0,0 +1,182 @@
+/*
+    JSON-lines progress events (see event_stream.h).
+*/
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <pthread.h>
+#include <time.h>
+#include "event_stream.h"
+
+#define EVENTS_LINE      160
+#define EVENTS_BUFFER    (64 << 10)
+#define EVENTS_POLL_NSEC 10000000   // 10 ms between drains
+
+int events_enabled = 0;
+static EventRing rings[EVENTS_MAX_THREADS + 1];
+
+static FILE *events_fp = NULL;
+static int events_failed;
+static pthread_t emitter_thread;
+static atomic_int emitter_stop;
+static double start_time, throughput_interval;
+static unsigned long long (*sample_nodes)(void);
+static char buffer[EVENTS_BUFFER];
+static size_t buffer_len;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void flush_buffer(void) {
+    if (buffer_len > 0 && !events_failed &&
+        (fwrite(buffer, 1, buffer_len, events_fp) != buffer_len || fflush(events_fp) != 0))
+        events_failed = 1;   // the reader went away: stop writing
+    buffer_len = 0;
+}
+
+static void append_line(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+static void append_line(const char *fmt, ...) {
+    if (EVENTS_BUFFER - buffer_len < EVENTS_LINE) flush_buffer();
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buffer + buffer_len, EVENTS_LINE, fmt, ap);
+    va_end(ap);
+    if (n > 0) buffer_len += n < EVENTS_LINE ? (size_t)n : EVENTS_LINE - 1;
+}
+
+static void format_event(const EventRecord *e, int thread) {
+    char source[24] = "";
+    if (thread != EVENTS_CONTROL) snprintf(source, sizeof(source), ",\"thread\":%d", thread);
+    switch (e->kind) {
+    case EVENT_INCUMBENT:
+        append_line("{\"t\":%.6f,\"event\":\"incumbent\",\"makespan\":%d%s}\n", e->time, e->value, source);
+        break;
+    case EVENT_LOWER_BOUND:
+        append_line("{\"t\":%.6f,\"event\":\"lower_bound\",\"value\":%d%s}\n", e->time, e->value, source);
+        break;
+    case EVENT_PHASE:
+        if (e->value < 0) append_line("{\"t\":%.6f,\"event\":\"phase\",\"phase\":\"%s\"}\n", e->time, e->phase);
+        else append_line("{\"t\":%.6f,\"event\":\"phase\",\"phase\":\"%s\",\"index\":%d}\n", e->time, e->phase, e->value);
+        break;
+    }
+}
+
+// Ready records of one drain, merged over the rings in time order
+typedef struct {
+    EventRecord record;
+    int thread;
+} PendingEvent;
+static PendingEvent pending[(EVENTS_MAX_THREADS + 1) * EVENTS_RING_RECORDS];
+
+static int by_time(const void *a, const void *b) {
+    double ta = ((const PendingEvent *)a)->record.time, tb = ((const PendingEvent *)b)->record.time;
+    return (ta > tb) - (ta < tb);
+}
+
+// Formats every ready record, oldest first.
+static void drain_rings(void) {
+    size_t n = 0;
+    for (int t = 0; t <= EVENTS_MAX_THREADS; t++) {
+        EventRing *ring = &rings[t];
+        uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        for (; tail < head; tail++) {
+            pending[n].record = ring->records[tail & (EVENTS_RING_RECORDS - 1)];
+            pending[n++].thread = t;
+        }
+        atomic_store_explicit(&ring->tail, tail, memory_order_release);
+    }
+    qsort(pending, n, sizeof(PendingEvent), by_time);
+    for (size_t i = 0; i < n; i++) format_event(&pending[i].record, pending[i].thread);
+}
+
+static unsigned long long last_nodes;
+static double last_sample;
+
+static void sample_throughput(double t) {
+    unsigned long long nodes = sample_nodes ? sample_nodes() : 0;
+    if (nodes < last_nodes) last_nodes = 0;   // the counters restart with each repetition
+    double rate = t > last_sample ? (nodes - last_nodes) / (t - last_sample) : 0.0;
+    append_line("{\"t\":%.6f,\"event\":\"throughput\",\"nodes\":%llu,\"nodes_per_sec\":%.0f}\n", t, nodes, rate);
+    last_nodes = nodes;
+    last_sample = t;
+}
+
+static void *emitter_main(void *arg) {
+    (void)arg;
+    const struct timespec idle = { 0, EVENTS_POLL_NSEC };
+    while (!atomic_load(&emitter_stop)) {
+        nanosleep(&idle, NULL);
+        drain_rings();
+        double t = now() - start_time;
+        if (throughput_interval > 0 && t - last_sample >= throughput_interval) sample_throughput(t);
+        flush_buffer();
+    }
+    return NULL;
+}
+
+int events_open(const char *filename, double interval, unsigned long long (*count_nodes)(void)) {
+    signal(SIGPIPE, SIG_IGN);   // a dashboard closing the FIFO must not end the search
+    events_fp = fopen(filename, "w");
+    if (!events_fp) return -1;
+    for (int t = 0; t <= EVENTS_MAX_THREADS; t++) {
+        atomic_store(&rings[t].head, 0);
+        atomic_store(&rings[t].tail, 0);
+        rings[t].dropped = 0;
+    }
+    start_time = now();
+    throughput_interval = interval;
+    sample_nodes = count_nodes;
+    last_nodes = 0;
+    last_sample = 0.0;
+    events_failed = 0;
+    buffer_len = 0;
+    atomic_store(&emitter_stop, 0);
+    if (pthread_create(&emitter_thread, NULL, emitter_main, NULL) != 0) {
+        fclose(events_fp);
+        events_fp = NULL;
+        return -1;
+    }
+    events_enabled = 1;
+    return 0;
+}
+
+// Appends a record to the caller's ring; drops it if the ring is full.
+void events_push(int thread, int kind, int value, const char *phase) {
+    if (thread < 0 || thread > EVENTS_MAX_THREADS) return;
+    EventRing *ring = &rings[thread];
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&ring->tail, memory_order_acquire) >= EVENTS_RING_RECORDS) {
+        ring->dropped++;
+        return;
+    }
+    EventRecord *e = &ring->records[head & (EVENTS_RING_RECORDS - 1)];
+    e->time = now() - start_time;
+    e->phase = phase;
+    e->kind = kind;
+    e->value = value;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+// Stops the emitter after it has written every pending event.
+void events_close(void) {
+    if (!events_fp) return;
+    events_enabled = 0;
+    atomic_store(&emitter_stop, 1);
+    pthread_join(emitter_thread, NULL);
+    drain_rings();
+    unsigned long long dropped = 0;
+    for (int t = 0; t <= EVENTS_MAX_THREADS; t++) dropped += rings[t].dropped;
+    double t = now() - start_time;
+    append_line("{\"t\":%.6f,\"event\":\"end\",\"nodes\":%llu,\"dropped\":%llu}\n",
+                t, sample_nodes ? sample_nodes() : 0ULL, dropped);
+    flush_buffer();
+    fclose(events_fp);
+    events_fp = NULL;
+}
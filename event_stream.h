@@ -0,0 +1,75 @@
+/*
+    Live progress events as JSON lines.
+
+    Search threads append fixed-size records to their own ring buffer
+    (single producer / single consumer, like branch_trace.h); one emitter
+    pthread formats them and writes one JSON object per line to the stream
+    (a file, or a FIFO a dashboard reads while the solver runs). A full ring
+    drops the event instead of waiting, so a search thread never blocks on
+    I/O; the final "end" event reports how many were dropped.
+
+        {"t":0.412,"event":"incumbent","makespan":943,"thread":3}
+        {"t":1.870,"event":"lower_bound","value":930,"thread":1}
+        {"t":2.000,"event":"throughput","nodes":81234567,"nodes_per_sec":40617283}
+        {"t":2.113,"event":"phase","phase":"lds_pass","index":2}
+        {"t":9.520,"event":"end","nodes":391234567,"dropped":0}
+
+    t is seconds since events_open(). "thread" is the search thread that
+    found the value; events of the controlling thread (phases, bounds
+    proven between passes) use EVENTS_CONTROL and carry no "thread".
+    Throughput events come from the emitter itself: every interval it
+    samples the solver's node counter through the callback given to
+    events_open().
+
+    Opening a FIFO blocks until a reader opens it. A reader that goes away
+    ends the stream (writes fail, SIGPIPE is ignored), not the search.
+*/
+
+#ifndef EVENT_STREAM_H
+#define EVENT_STREAM_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include "worker_pool.h"
+
+#define EVENTS_MAX_THREADS  (POOL_MAX_WORKERS + 1)   // search threads (PAR_MAX_SLOTS)
+#define EVENTS_CONTROL      EVENTS_MAX_THREADS   // ring of the controlling thread
+#define EVENTS_RING_RECORDS 1024        // per thread, power of two
+
+typedef enum { EVENT_INCUMBENT, EVENT_LOWER_BOUND, EVENT_PHASE } EventKind;
+
+typedef struct {
+    double time;               // seconds since events_open()
+    const char *phase;         // EVENT_PHASE: name (string literal)
+    int32_t kind;
+    int32_t value;             // makespan, bound or phase index (-1: none)
+} EventRecord;                 // 24 bytes
+
+typedef struct {
+    _Alignas(64) _Atomic uint64_t head;   // written by the producer
+    uint64_t dropped;
+    _Alignas(64) _Atomic uint64_t tail;   // written by the emitter
+    _Alignas(64) EventRecord records[EVENTS_RING_RECORDS];
+} EventRing;
+
+extern int events_enabled;
+
+// interval: seconds between throughput events (0: none); count_nodes may be NULL.
+int  events_open(const char *filename, double interval, unsigned long long (*count_nodes)(void));
+void events_push(int thread, int kind, int value, const char *phase);
+void events_close(void);   // writes the pending events and the "end" event
+
+static inline void events_incumbent(int thread, int makespan) {
+    if (events_enabled) events_push(thread, EVENT_INCUMBENT, makespan, NULL);
+}
+
+static inline void events_lower_bound(int thread, int bound) {
+    if (events_enabled) events_push(thread, EVENT_LOWER_BOUND, bound, NULL);
+}
+
+// From the controlling thread only (outside parallel regions).
+static inline void events_phase(const char *phase, int index) {
+    if (events_enabled) events_push(EVENTS_CONTROL, EVENT_PHASE, index, phase);
+}
+
+#endif
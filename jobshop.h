@@ -0,0 +1,38 @@
+/*
+    Shared Job-Shop definitions used by the solver modules.
+
+    Every solver keeps its schedule in a static table
+    Operation table[MAX_JOBS][MAX_OPS], but MAX_OPS differs between programs
+    (10 in the branch-and-bound mains, 100 in trabalho/). Modules therefore take
+    a ScheduleView, which records the row stride of the caller's table:
+
+        ScheduleView v = SCHEDULE_VIEW(best_schedule, num_jobs, num_ops, num_machines);
+*/
+
+#ifndef JOBSHOP_H
+#define JOBSHOP_H
+
+#define JSS_MAX_MACHINES   100
+#define JSS_MAX_OPERATIONS 50000   // 1000 jobs x 50 machines stress instances
+
+typedef struct {
+    int machine;
+    int duration;
+    int start;
+    int end;
+} Operation;
+
+typedef struct {
+    const Operation *ops;   // &table[0][0]
+    int stride;             // row length (MAX_OPS) of the caller's table
+    int num_jobs;
+    int num_ops;
+    int num_machines;
+} ScheduleView;
+
+#define SCHEDULE_VIEW(table, nj, no, nm) \
+    ((ScheduleView){ &(table)[0][0], (int)(sizeof((table)[0]) / sizeof(Operation)), (nj), (no), (nm) })
+
+#define VIEW_OP(v, j, i) ((v).ops[(j) * (v).stride + (i)])
+
+#endif
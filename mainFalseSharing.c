@@ -0,0 +1,141 @@
+/*
+    False-sharing microbenchmark: packed vs cache-line-padded shared state.
+
+    Three access patterns of the solvers, each run with the packed layout
+    they used to have and the padded layout of cache_layout.h:
+    - counters: every thread increments its own counter (step counters,
+      per-thread node counts)
+    - machines: threads lock a machine, update its availability, unlock
+      (machine_available[] / machine_lock[] of mainV3Optimized.c); each
+      thread works on its own machine, so only false sharing can collide
+    - incumbent: one thread writes the best value while the others read
+      a neighbouring flag at every node (best_makespan / interrupted)
+
+    With one core (or one thread) both layouts take the same time; the gap
+    grows with the number of cores that write neighbouring variables.
+
+    📄 Compilar:
+    gcc -fopenmp -Wall -O2 -o false_sharing mainFalseSharing.c
+
+    🚀 Executar:
+    ./false_sharing [threads] [milhões de operações por thread]
+    ./false_sharing 8 50
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <omp.h>
+#include "cache_layout.h"
+
+#define MAX_THREADS 64
+
+// ================== Layouts ==================
+
+atomic_ullong packed_counters[MAX_THREADS];
+
+typedef struct {
+    CACHE_ALIGNED atomic_ullong value;
+} PaddedCounter;
+PaddedCounter padded_counters[MAX_THREADS];
+
+int packed_available[MAX_THREADS];
+omp_lock_t packed_lock[MAX_THREADS];
+
+typedef struct {
+    CACHE_ALIGNED int available;
+    omp_lock_t lock;
+} MachineSlot;
+MachineSlot machine_slots[MAX_THREADS];
+
+struct {
+    atomic_int best;
+    atomic_int interrupted;
+} packed_incumbent;
+
+struct {
+    CACHE_ALIGNED atomic_int best;
+    CACHE_ALIGNED atomic_int interrupted;
+} padded_incumbent;
+
+// ================== Patterns ==================
+
+double run_counters(int threads, long long ops, int padded) {
+    double t0 = omp_get_wtime();
+    #pragma omp parallel num_threads(threads)
+    {
+        int t = omp_get_thread_num();
+        atomic_ullong *c = padded ? &padded_counters[t].value : &packed_counters[t];
+        for (long long i = 0; i < ops; i++)
+            atomic_store_explicit(c, atomic_load_explicit(c, memory_order_relaxed) + 1, memory_order_relaxed);
+    }
+    return omp_get_wtime() - t0;
+}
+
+double run_machines(int threads, long long ops, int padded) {
+    for (int m = 0; m < threads; m++) {
+        omp_init_lock(&packed_lock[m]);
+        omp_init_lock(&machine_slots[m].lock);
+        packed_available[m] = machine_slots[m].available = 0;
+    }
+    double t0 = omp_get_wtime();
+    #pragma omp parallel num_threads(threads)
+    {
+        int m = omp_get_thread_num();
+        omp_lock_t *lock = padded ? &machine_slots[m].lock : &packed_lock[m];
+        int *available = padded ? &machine_slots[m].available : &packed_available[m];
+        for (long long i = 0; i < ops; i++) {
+            omp_set_lock(lock);
+            *available += 1;
+            omp_unset_lock(lock);
+        }
+    }
+    double elapsed = omp_get_wtime() - t0;
+    for (int m = 0; m < threads; m++) {
+        omp_destroy_lock(&packed_lock[m]);
+        omp_destroy_lock(&machine_slots[m].lock);
+    }
+    return elapsed;
+}
+
+// Thread 0 keeps improving the incumbent; the others poll the interrupt flag.
+double run_incumbent(int threads, long long ops, int padded) {
+    atomic_int *best = padded ? &padded_incumbent.best : &packed_incumbent.best;
+    atomic_int *flag = padded ? &padded_incumbent.interrupted : &packed_incumbent.interrupted;
+    double t0 = omp_get_wtime();
+    #pragma omp parallel num_threads(threads)
+    {
+        if (omp_get_thread_num() == 0) {
+            for (long long i = 0; i < ops; i++) atomic_store_explicit(best, (int)i, memory_order_relaxed);
+        } else {
+            for (long long i = 0; i < ops && !atomic_load_explicit(flag, memory_order_relaxed); i++)
+                continue;
+        }
+    }
+    return omp_get_wtime() - t0;
+}
+
+// ================== Main ==================
+
+int main(int argc, char *argv[]) {
+    int threads = argc > 1 ? atoi(argv[1]) : omp_get_max_threads();
+    long long ops = (argc > 2 ? atoll(argv[2]) : 20) * 1000000LL;
+    if (threads < 1 || threads > MAX_THREADS || ops < 1) {
+        fprintf(stderr, "Uso: %s [threads 1..%d] [milhões de operações por thread]\n", argv[0], MAX_THREADS);
+        return EXIT_FAILURE;
+    }
+
+    const char *names[3] = { "counters", "machines", "incumbent" };
+    double (*patterns[3])(int, long long, int) = { run_counters, run_machines, run_incumbent };
+
+    printf("threads=%d | %lld operações por thread | linha de cache=%d bytes\n", threads, ops, CACHE_LINE);
+    printf("%-10s %12s %12s %8s\n", "padrão", "packed ns/op", "padded ns/op", "razão");
+    for (int p = 0; p < 3; p++) {
+        patterns[p](threads, ops / 10, 0);   // aquecimento
+        double packed = patterns[p](threads, ops, 0);
+        double padded = patterns[p](threads, ops, 1);
+        printf("%-10s %12.2f %12.2f %7.2fx\n", names[p],
+               packed * 1e9 / ops, padded * 1e9 / ops, packed / padded);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,209 @@
+/*
+    Random instance generator (Taillard-style job-shop and flexible job-shop).
+
+    Job-shop (.jss): every job visits every machine once, in a random order
+    (random permutation per job, as in Taillard's benchmarks), with random
+    durations. Flexible (.fjs, Brandimarte format): every operation gets
+    between --alts=K or --alts=KMIN-KMAX distinct eligible machines, each with
+    its own duration (base duration +/- --spread percent).
+
+    All values come from counter_rng.h as a function of (seed, job, operation,
+    field), so the same seed always gives the same instance, independently of
+    the order or the thread in which jobs are generated.
+
+    Duration distributions (--dist):
+    - uniform: integer in [min, max] (Taillard: 1..99)
+    - normal:  mean (min+max)/2, sd (max-min)/6, clipped to [min, max]
+    - bimodal: 80% short ops in the lowest fifth of the range, 20% long ops
+               in the highest fifth
+
+    📄 Compilar:
+    gcc -Wall -O2 -o gen_instance mainGenerateInstance.c schedule_output.c -lm
+
+    🚀 Executar:
+    ./gen_instance Matrizes/gen20x10.jss --jobs=20 --machines=10 --seed=1
+    ./gen_instance mk_like.fjs --jobs=10 --machines=6 --alts=1-3 --min=1 --max=9
+    ./gen_instance stress1000x50.jss --jobs=1000 --machines=50 --seed=7      (corpus de stress)
+    ./gen_instance stress1000x50.fjs --jobs=1000 --machines=50 --alts=2-5 --seed=7
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "jobshop.h"
+#include "counter_rng.h"
+#include "schedule_output.h"
+
+#define GEN_MAX_JOBS     10000
+#define GEN_MAX_MACHINES JSS_MAX_MACHINES
+
+// Counter layout: field kind in the top bits, then operation, then index.
+#define CTR(kind, op, k) (((uint64_t)(kind) << 52) | ((uint64_t)(op) << 24) | (uint64_t)(k))
+enum { FIELD_ROUTE, FIELD_DURATION, FIELD_ALT_COUNT, FIELD_ALT_PICK, FIELD_ALT_SPREAD, FIELD_MODE };
+
+typedef enum { DIST_UNIFORM, DIST_NORMAL, DIST_BIMODAL } Distribution;
+
+typedef struct {
+    int jobs, machines;
+    int min_duration, max_duration;
+    Distribution dist;
+    int alts_min, alts_max;      // 0 = classic job-shop
+    int spread;                  // percent variation of alternative durations
+    uint64_t seed;
+} GeneratorConfig;
+
+// ================== Sampling ==================
+
+static int clamp(int v, int lo, int hi) { return v < lo ? lo : v > hi ? hi : v; }
+
+int sample_duration(const GeneratorConfig *c, int job, int op, int k) {
+    int lo = c->min_duration, hi = c->max_duration;
+    switch (c->dist) {
+    case DIST_NORMAL: {
+        double mean = (lo + hi) / 2.0, sd = (hi - lo) / 6.0;
+        double z = crng_normal(c->seed, job, CTR(FIELD_DURATION, op, k));
+        return clamp((int)(mean + sd * z + 0.5), lo, hi);
+    }
+    case DIST_BIMODAL: {
+        int fifth = (hi - lo) / 5;
+        int long_op = crng_unit(c->seed, job, CTR(FIELD_MODE, op, k)) < 0.2;
+        if (long_op) return crng_range(c->seed, job, CTR(FIELD_DURATION, op, k), hi - fifth, hi);
+        return crng_range(c->seed, job, CTR(FIELD_DURATION, op, k), lo, lo + fifth);
+    }
+    default:
+        return crng_range(c->seed, job, CTR(FIELD_DURATION, op, k), lo, hi);
+    }
+}
+
+// Machine order of a job: Fisher-Yates driven by counters (no shared state).
+void job_route(const GeneratorConfig *c, int job, int *route) {
+    for (int m = 0; m < c->machines; m++) route[m] = m;
+    for (int a = c->machines - 1; a > 0; a--) {
+        int b = crng_range(c->seed, job, CTR(FIELD_ROUTE, 0, a), 0, a);
+        int tmp = route[a]; route[a] = route[b]; route[b] = tmp;
+    }
+}
+
+// ================== Writers ==================
+
+void write_jss(OutputWriter *w, const GeneratorConfig *c) {
+    int route[GEN_MAX_MACHINES];
+    writer_printf(w, "%d %d\n", c->jobs, c->machines);
+    for (int j = 0; j < c->jobs; j++) {
+        job_route(c, j, route);
+        for (int i = 0; i < c->machines; i++) {
+            if (i) writer_char(w, ' ');
+            writer_int(w, route[i]);
+            writer_char(w, ' ');
+            writer_int(w, sample_duration(c, j, i, 0));
+        }
+        writer_char(w, '\n');
+    }
+}
+
+/*
+    One operation per machine of the job's route; the routed machine is always
+    eligible and the other alternatives are a random subset of the remaining
+    machines (partial Fisher-Yates). Machines are written 1-based.
+*/
+void write_fjs(OutputWriter *w, const GeneratorConfig *c) {
+    int route[GEN_MAX_MACHINES], pool[GEN_MAX_MACHINES];
+    long long total_alts = 0;
+    for (int j = 0; j < c->jobs; j++)
+        for (int i = 0; i < c->machines; i++)
+            total_alts += crng_range(c->seed, j, CTR(FIELD_ALT_COUNT, i, 0), c->alts_min, c->alts_max);
+    writer_printf(w, "%d %d %.2f\n", c->jobs, c->machines, (double)total_alts / ((double)c->jobs * c->machines));
+
+    for (int j = 0; j < c->jobs; j++) {
+        job_route(c, j, route);
+        writer_int(w, c->machines);
+        for (int i = 0; i < c->machines; i++) {
+            int k = crng_range(c->seed, j, CTR(FIELD_ALT_COUNT, i, 0), c->alts_min, c->alts_max);
+            int base = sample_duration(c, j, i, 0);
+
+            pool[0] = route[i];
+            for (int m = 0, n = 1; m < c->machines; m++)
+                if (m != route[i]) pool[n++] = m;
+            for (int a = 1; a < k; a++) {
+                int b = crng_range(c->seed, j, CTR(FIELD_ALT_PICK, i, a), a, c->machines - 1);
+                int tmp = pool[a]; pool[a] = pool[b]; pool[b] = tmp;
+            }
+
+            writer_printf(w, "  %d", k);
+            for (int a = 0; a < k; a++) {
+                int d = base;
+                if (a > 0 && c->spread > 0) {
+                    int delta = base * c->spread / 100;
+                    d = base + crng_range(c->seed, j, CTR(FIELD_ALT_SPREAD, i, a), -delta, delta);
+                    if (d < 1) d = 1;
+                }
+                writer_printf(w, " %d %d", pool[a] + 1, d);
+            }
+        }
+        writer_char(w, '\n');
+    }
+}
+
+// ================== Main ==================
+
+static int ends_with(const char *s, const char *suffix) {
+    size_t n = strlen(s), k = strlen(suffix);
+    return n >= k && strcmp(s + n - k, suffix) == 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Uso: %s saida.jss|saida.fjs --jobs=N --machines=M [--seed=S] [--min=A] [--max=B]\n"
+                        "       [--dist=uniform|normal|bimodal] [--alts=K|KMIN-KMAX] [--spread=P]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    GeneratorConfig c = { 10, 10, 1, 99, DIST_UNIFORM, 0, 0, 20, 1 };
+    int flexible = ends_with(argv[1], ".fjs");
+    for (int a = 2; a < argc; a++) {
+        const char *arg = argv[a];
+        if (strncmp(arg, "--jobs=", 7) == 0) c.jobs = atoi(arg + 7);
+        else if (strncmp(arg, "--machines=", 11) == 0) c.machines = atoi(arg + 11);
+        else if (strncmp(arg, "--seed=", 7) == 0) c.seed = strtoull(arg + 7, NULL, 10);
+        else if (strncmp(arg, "--min=", 6) == 0) c.min_duration = atoi(arg + 6);
+        else if (strncmp(arg, "--max=", 6) == 0) c.max_duration = atoi(arg + 6);
+        else if (strncmp(arg, "--spread=", 9) == 0) c.spread = atoi(arg + 9);
+        else if (strncmp(arg, "--alts=", 7) == 0) {
+            if (sscanf(arg + 7, "%d-%d", &c.alts_min, &c.alts_max) != 2) c.alts_max = c.alts_min;
+        }
+        else if (strcmp(arg, "--dist=uniform") == 0) c.dist = DIST_UNIFORM;
+        else if (strcmp(arg, "--dist=normal") == 0) c.dist = DIST_NORMAL;
+        else if (strcmp(arg, "--dist=bimodal") == 0) c.dist = DIST_BIMODAL;
+        else { fprintf(stderr, "Opção desconhecida: %s\n", arg); return EXIT_FAILURE; }
+    }
+    if (flexible && c.alts_min == 0) { c.alts_min = 1; c.alts_max = c.machines; }
+
+    if (c.jobs < 1 || c.jobs > GEN_MAX_JOBS || c.machines < 1 || c.machines > GEN_MAX_MACHINES ||
+        c.min_duration < 0 || c.max_duration < c.min_duration || c.spread < 0) {
+        fprintf(stderr, "Parâmetros inválidos (jobs 1..%d, máquinas 1..%d, 0 <= min <= max)\n",
+                GEN_MAX_JOBS, GEN_MAX_MACHINES);
+        return EXIT_FAILURE;
+    }
+    if (!flexible && c.alts_min > 0) {
+        fprintf(stderr, "--alts só se aplica a ficheiros .fjs\n");
+        return EXIT_FAILURE;
+    }
+    if (flexible && (c.alts_min < 1 || c.alts_max < c.alts_min || c.alts_max > c.machines)) {
+        fprintf(stderr, "--alts inválido (1 <= KMIN <= KMAX <= máquinas)\n");
+        return EXIT_FAILURE;
+    }
+
+    FILE *fp = fopen(argv[1], "w");
+    if (!fp) { perror("Erro ao criar ficheiro"); return EXIT_FAILURE; }
+    static OutputWriter w;
+    writer_init(&w, fp);
+    if (flexible) write_fjs(&w, &c);
+    else write_jss(&w, &c);
+    writer_flush(&w);
+    fclose(fp);
+
+    fprintf(stderr, "%s: %d jobs x %d máquinas (%s, seed %llu)\n", argv[1], c.jobs, c.machines,
+            flexible ? "flexível" : "job-shop", (unsigned long long)c.seed);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,192 @@
+/*
+    Compact node encoding benchmark (node_codec.h): nodes per GB and
+    encode/decode rates.
+
+    Builds random frontier nodes for an instance: each node is a random dive
+    of append decisions (the V6 child rule) to a uniform random depth.
+    Every node is encoded into one static buffer, decoded back and its
+    schedule rebuilt from the path; any mismatch with the dive aborts the
+    run. Reports the size of a full node (partial schedule plus the three
+    state arrays, with rows sized to the instance), the compact size in
+    fixed-size slots (node_max_bytes) and packed back to back, and the
+    matching nodes per GB.
+
+    📄 Compilar:
+    gcc -fopenmp -Wall -O2 -o node_codec mainNodeCodec.c node_codec.c
+
+    🚀 Executar:
+    ./node_codec instance.jss [nodes] [seed]
+    ./node_codec Matrizes/ft10.jss 200000 1
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "jobshop.h"
+#include "counter_rng.h"
+#include "node_codec.h"
+
+#define MAX_JOBS     NODE_MAX_JOBS
+#define MAX_OPS      NODE_MAX_OPS
+#define MAX_MACHINES NODE_MAX_MACHINES
+#define BENCH_BYTES  ((size_t)256 << 20)   // encoded nodes, back to back
+#define MAX_NODES    1000000
+
+int num_jobs, num_machines, num_ops;
+Operation ops[MAX_JOBS][MAX_OPS];
+Operation rebuilt[MAX_JOBS][MAX_OPS];
+NodeCodec codec;
+
+static uint8_t encoded[BENCH_BYTES];
+static size_t offsets[MAX_NODES + 1];
+static int depths[MAX_NODES];
+
+// ================== Input ==================
+void read_input(const char *filename) {
+    FILE *fp = fopen(filename, "r");
+    if (!fp) { perror("Error opening input file"); exit(EXIT_FAILURE); }
+    if (fscanf(fp, "%d %d", &num_jobs, &num_machines) != 2) {
+        fprintf(stderr, "Invalid input format\n"); fclose(fp); exit(EXIT_FAILURE);
+    }
+    num_ops = num_machines;
+    if (node_codec_init(&codec, num_jobs, num_ops, num_machines) != 0) {
+        fprintf(stderr, "Instance too large (at most %d jobs x %d machines)\n", MAX_JOBS, MAX_OPS);
+        fclose(fp); exit(EXIT_FAILURE);
+    }
+    for (int j = 0; j < num_jobs; j++)
+        for (int i = 0; i < num_ops; i++)
+            if (fscanf(fp, "%d %d", &ops[j][i].machine, &ops[j][i].duration) != 2 ||
+                ops[j][i].machine < 0 || ops[j][i].machine >= num_machines) {
+                fprintf(stderr, "Invalid operation data\n"); fclose(fp); exit(EXIT_FAILURE);
+            }
+    fclose(fp);
+}
+
+// ================== Random Frontier Nodes ==================
+typedef struct {
+    int job_progress[MAX_JOBS], job_ready[MAX_JOBS], machine_ready[MAX_MACHINES];
+    int path[MAX_JOBS * MAX_OPS];
+    int depth;
+} Dive;
+
+// Node n of the run: a dive of random append decisions, reproducible per (seed, n).
+static void random_dive(Dive *d, uint64_t seed, int n, Operation (*schedule)[MAX_OPS]) {
+    memset(d->job_progress, 0, sizeof(int) * num_jobs);
+    memset(d->job_ready, 0, sizeof(int) * num_jobs);
+    memset(d->machine_ready, 0, sizeof(int) * num_machines);
+    d->depth = crng_range(seed, n, 0, 0, num_jobs * num_ops);
+    for (int k = 0; k < d->depth; k++) {
+        int j = crng_range(seed, n, k + 1, 0, num_jobs - 1);
+        while (d->job_progress[j] >= num_ops) j = (j + 1) % num_jobs;
+        int i = d->job_progress[j]++;
+        int m = ops[j][i].machine;
+        int start = d->machine_ready[m] > d->job_ready[j] ? d->machine_ready[m] : d->job_ready[j];
+        d->job_ready[j] = d->machine_ready[m] = start + ops[j][i].duration;
+        if (schedule) { schedule[j][i].start = start; schedule[j][i].end = start + ops[j][i].duration; }
+        d->path[k] = j;
+    }
+}
+
+static void mismatch(int n, const char *what) {
+    fprintf(stderr, "Node %d: %s differs after decoding\n", n, what);
+    exit(EXIT_FAILURE);
+}
+
+// ================== Main ==================
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s instance.jss [nodes] [seed]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    read_input(argv[1]);
+    int nodes = argc > 2 ? atoi(argv[2]) : 200000;
+    uint64_t seed = argc > 3 ? strtoull(argv[3], NULL, 10) : 1;
+    size_t slot = node_max_bytes(&codec);
+    if (nodes < 1) nodes = 1;
+    if (nodes > MAX_NODES) nodes = MAX_NODES;
+    if ((size_t)nodes * slot > BENCH_BYTES) nodes = (int)(BENCH_BYTES / slot);
+
+    static Dive dive;
+    static int progress[MAX_JOBS], job_ready[MAX_JOBS], machine_ready[MAX_MACHINES];
+
+    // Encode (the dives are replayed below, so only encoding is timed here)
+    double dive_time = 0, encode_time = 0;
+    int overflow = 0;
+    offsets[0] = 0;
+    for (int n = 0; n < nodes; n++) {
+        double t0 = omp_get_wtime();
+        random_dive(&dive, seed, n, NULL);
+        double t1 = omp_get_wtime();
+        int bytes = node_encode(&codec, encoded + offsets[n], dive.job_progress, dive.job_ready,
+                                dive.machine_ready, dive.path, dive.depth);
+        encode_time += omp_get_wtime() - t1;
+        dive_time += t1 - t0;
+        if (bytes < 0) { overflow++; bytes = 0; }
+        offsets[n + 1] = offsets[n] + (size_t)bytes;
+        depths[n] = bytes > 0 ? dive.depth : -1;
+    }
+
+    // Decode the state the bound reads
+    double t0 = omp_get_wtime();
+    long long checksum = 0;
+    for (int n = 0; n < nodes; n++) {
+        if (depths[n] < 0) continue;
+        node_decode_state(&codec, encoded + offsets[n], progress, job_ready, machine_ready);
+        checksum += job_ready[0] + machine_ready[0] + progress[0];
+    }
+    double decode_time = omp_get_wtime() - t0;
+
+    // Rebuild full schedules from the paths
+    memcpy(rebuilt, ops, sizeof(ops));
+    t0 = omp_get_wtime();
+    for (int n = 0; n < nodes; n++) {
+        if (depths[n] < 0) continue;
+        if (node_rebuild_schedule(&codec, encoded + offsets[n], &rebuilt[0][0], MAX_OPS) != 0)
+            mismatch(n, "rebuilt state");
+        checksum += rebuilt[0][0].end;
+    }
+    double rebuild_time = omp_get_wtime() - t0;
+
+    // Verify every node against its dive (untimed)
+    static Operation expected[MAX_JOBS][MAX_OPS];
+    static int path[MAX_JOBS * MAX_OPS];
+    for (int n = 0; n < nodes; n++) {
+        if (depths[n] < 0) continue;
+        random_dive(&dive, seed, n, expected);
+        int depth = node_decode_state(&codec, encoded + offsets[n], progress, job_ready, machine_ready);
+        if (depth != dive.depth) mismatch(n, "depth");
+        if (memcmp(progress, dive.job_progress, sizeof(int) * num_jobs) != 0) mismatch(n, "job_progress");
+        if (memcmp(job_ready, dive.job_ready, sizeof(int) * num_jobs) != 0) mismatch(n, "job_ready");
+        if (memcmp(machine_ready, dive.machine_ready, sizeof(int) * num_machines) != 0) mismatch(n, "machine_ready");
+        node_decode_path(&codec, encoded + offsets[n], path);
+        if (memcmp(path, dive.path, sizeof(int) * depth) != 0) mismatch(n, "path");
+        node_rebuild_schedule(&codec, encoded + offsets[n], &rebuilt[0][0], MAX_OPS);
+        for (int j = 0; j < num_jobs; j++)
+            for (int i = 0; i < dive.job_progress[j]; i++)
+                if (rebuilt[j][i].start != expected[j][i].start || rebuilt[j][i].end != expected[j][i].end)
+                    mismatch(n, "schedule");
+    }
+
+    int encoded_nodes = nodes - overflow;
+    double packed = encoded_nodes ? (double)offsets[nodes] / encoded_nodes : 0;
+    double depth_sum = 0;
+    for (int n = 0; n < nodes; n++) if (depths[n] >= 0) depth_sum += depths[n];
+    size_t full = (size_t)num_jobs * num_ops * sizeof(Operation) + (size_t)(2 * num_jobs + num_machines) * sizeof(int);
+    const double gb = 1e9;
+
+    printf("Instance: %s (%d jobs x %d machines) | %d nodes, mean depth %.1f of %d | seed %llu\n",
+           argv[1], num_jobs, num_machines, nodes, encoded_nodes ? depth_sum / encoded_nodes : 0,
+           num_jobs * num_ops, (unsigned long long)seed);
+    printf("Layout: %d header bytes | %d bits per job_progress | %d bits per decision\n",
+           codec.header_bytes, codec.progress_bits, codec.job_bits);
+    printf("%-24s %10s %16s\n", "Node format", "bytes", "nodes per GB");
+    printf("%-24s %10zu %16.0f\n", "full (schedule + state)", full, gb / full);
+    printf("%-24s %10zu %16.0f\n", "compact, fixed slots", slot, gb / slot);
+    printf("%-24s %10.1f %16.0f\n", "compact, packed", packed, packed > 0 ? gb / packed : 0);
+    printf("Not encodable (16-bit delta overflow): %d\n", overflow);
+    printf("Encode: %.1f ns/node | decode state: %.1f ns/node | rebuild schedule: %.1f ns/node | dive: %.1f ns/node\n",
+           1e9 * encode_time / nodes, 1e9 * decode_time / nodes, 1e9 * rebuild_time / nodes, 1e9 * dive_time / nodes);
+    printf("Round trip verified for all %d nodes (checksum %lld)\n", encoded_nodes, checksum);
+    return EXIT_SUCCESS;
+}
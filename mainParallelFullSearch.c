@@ -0,0 +1,379 @@
+/*
+    Parallel Exhaustive Job-Shop Scheduler (Full Search, OpenMP)
+
+    ✅ Funcionalidades:
+    - Percorre todas as alternativas (sem poda), como mainSequentialFullSearch.c;
+    - Partição estática por prefixos: a árvore é expandida em largura até haver
+      subárvores independentes suficientes (PREFIXES_PER_THREAD por thread);
+    - Cada thread começa com um intervalo contíguo de prefixos e rouba metade
+      do intervalo de outra thread quando o seu acaba (work-stealing sem locks);
+    - Contadores de nós e folhas por thread, reduzidos no fim;
+    - NUMA (numa_topology.h): cada thread tem um nó (blocos contíguos de
+      threads por nó), rouba primeiro às threads do mesmo nó, usa a cópia da
+      instância do seu nó e inicializa ela própria o seu estado (first-touch);
+      com --pin fica também fixa num CPU desse nó;
+    - O ótimo e o tamanho exato da árvore são iguais para qualquer número de
+      threads (o calendário devolvido é o primeiro ótimo na ordem da árvore).
+
+    Serve de oráculo para validar o branch-and-bound em instâncias 4x4 a 6x6.
+
+    📄 Compilar:
+    gcc -fopenmp -Wall -O2 -pthread -o main_par_full mainParallelFullSearch.c branch_trace.c schedule_output.c numa_topology.c
+
+    🚀 Executar:
+    ./main_par_full ft03.jss output.txt 4 1
+    ./main_par_full ft03.jss output.txt 4 1 --trace=branches.trc --trace-depth=4
+    ./main_par_full ft06.jss output.txt 32 1 --pin
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <limits.h>
+#include <signal.h>
+#include <omp.h>
+#include "jobshop.h"
+#include "branch_trace.h"
+#include "schedule_output.h"
+#include "numa_topology.h"
+
+#define MAX_JOBS            10
+#define MAX_OPS             10
+#define MAX_MACHINES        10
+#define MAX_REPEATS         100
+#define MAX_THREADS         TRACE_MAX_THREADS
+#define MAX_PREFIXES        65536
+#define MAX_PREFIX_DEPTH    32
+#define PREFIXES_PER_THREAD 64
+
+// Estado de uma subárvore: alterado no lugar e reposto ao voltar atrás
+typedef struct {
+    int job_progress[MAX_JOBS];
+    int job_ready[MAX_JOBS];
+    int machine_ready[MAX_MACHINES];
+    Operation schedule[MAX_JOBS][MAX_OPS];
+} SearchState;
+
+// Contadores por thread, cada um nas suas páginas (escritas primeiro pela própria thread)
+typedef struct {
+    _Alignas(NUMA_PAGE) unsigned long long nodes;
+    unsigned long long leaves;
+    unsigned long long steals;
+    int best_makespan;
+    int best_prefix;                          // prefixo onde o melhor foi encontrado
+    Operation best_schedule[MAX_JOBS][MAX_OPS];
+} WorkerStats;
+
+// Intervalo [lo, hi) de prefixos por thread, empacotado em 64 bits para CAS
+typedef struct {
+    _Alignas(64) _Atomic uint64_t range;
+} WorkRange;
+
+int num_jobs, num_machines, num_ops;
+Operation ops_backup[MAX_JOBS][MAX_OPS];
+Operation best_schedule[MAX_JOBS][MAX_OPS];
+int best_makespan = INT_MAX;
+unsigned long long total_nodes = 0, total_leaves = 0;
+volatile sig_atomic_t interrupted = 0;
+int verbose_mode = 0;
+
+unsigned char prefix_paths[2][MAX_PREFIXES][MAX_PREFIX_DEPTH];
+int num_prefixes, prefix_depth;
+unsigned long long prefix_nodes;   // nós acima da profundidade dos prefixos
+WorkerStats worker_stats[MAX_THREADS];
+WorkRange work_ranges[MAX_THREADS];
+
+// Instância (só leitura) replicada por nó NUMA, cada cópia nas suas páginas
+typedef struct {
+    _Alignas(NUMA_PAGE) Operation ops[MAX_JOBS][MAX_OPS];
+} InstanceReplica;
+InstanceReplica replicas[NUMA_MAX_NODES];
+static _Thread_local Operation (*ops_local)[MAX_OPS] = ops_backup;
+
+NumaTopology topology;
+int pin_threads = 0;
+int victim_order[MAX_THREADS][MAX_THREADS];
+
+void handle_interrupt(int signum) {
+    (void)signum;
+    interrupted = 1;
+}
+
+void read_input(const char *filename) {
+    FILE *fp = fopen(filename, "r");
+    if (!fp) { perror("Erro ao abrir ficheiro"); exit(EXIT_FAILURE); }
+    if (fscanf(fp, "%d %d", &num_jobs, &num_machines) != 2 ||
+        num_jobs > MAX_JOBS || num_machines > MAX_MACHINES) {
+        fprintf(stderr, "Formato inválido\n"); fclose(fp); exit(EXIT_FAILURE);
+    }
+    num_ops = num_machines;
+    for (int j = 0; j < num_jobs; j++) {
+        for (int i = 0; i < num_ops; i++) {
+            if (fscanf(fp, "%d %d", &ops_backup[j][i].machine, &ops_backup[j][i].duration) != 2) {
+                fprintf(stderr, "Erro leitura de operações\n"); fclose(fp); exit(EXIT_FAILURE);
+            }
+        }
+    }
+    fclose(fp);
+}
+
+static uint64_t pack_range(uint32_t lo, uint32_t hi) { return (uint64_t)lo << 32 | hi; }
+static uint32_t range_lo(uint64_t r) { return (uint32_t)(r >> 32); }
+static uint32_t range_hi(uint64_t r) { return (uint32_t)r; }
+
+// Agenda a próxima operação do job j no estado s; devolve o fim da operação.
+static int apply_decision(SearchState *s, int j) {
+    int i = s->job_progress[j];
+    int m = ops_local[j][i].machine;
+    int d = ops_local[j][i].duration;
+    int start = s->machine_ready[m] > s->job_ready[j] ? s->machine_ready[m] : s->job_ready[j];
+    s->schedule[j][i] = (Operation){ m, d, start, start + d };
+    s->machine_ready[m] = start + d;
+    s->job_ready[j] = start + d;
+    s->job_progress[j]++;
+    return start + d;
+}
+
+// Reconstrói o estado de um prefixo a partir do caminho de decisões.
+static int replay_prefix(SearchState *s, const unsigned char *path, int depth) {
+    memset(s, 0, sizeof(*s));
+    int makespan = 0;
+    for (int k = 0; k < depth; k++) {
+        int end = apply_decision(s, path[k]);
+        if (end > makespan) makespan = end;
+    }
+    return makespan;
+}
+
+/*
+    Expande a árvore em largura até haver prefixos suficientes para as threads.
+    Os prefixos ficam em ordem lexicográfica (a mesma ordem da pesquisa em
+    profundidade), o que torna o ótimo devolvido independente das threads.
+*/
+int build_prefixes(int threads) {
+    static SearchState s;
+    int total_ops = num_jobs * num_ops;
+    int target = threads * PREFIXES_PER_THREAD;
+    int cur = 0;
+
+    num_prefixes = 1;
+    prefix_depth = 0;
+    prefix_nodes = 0;
+    while (num_prefixes < target && prefix_depth < total_ops && prefix_depth < MAX_PREFIX_DEPTH) {
+        int next = 0;
+        for (int p = 0; p < num_prefixes; p++) {
+            replay_prefix(&s, prefix_paths[cur][p], prefix_depth);
+            for (int j = 0; j < num_jobs; j++) {
+                if (s.job_progress[j] >= num_ops) continue;
+                if (next == MAX_PREFIXES) return cur;   // nível seguinte não cabe: fica neste
+                memcpy(prefix_paths[1 - cur][next], prefix_paths[cur][p], prefix_depth);
+                prefix_paths[1 - cur][next][prefix_depth] = (unsigned char)j;
+                next++;
+            }
+        }
+        prefix_nodes += num_prefixes;
+        num_prefixes = next;
+        prefix_depth++;
+        cur = 1 - cur;
+    }
+    return cur;
+}
+
+// Pesquisa exaustiva de uma subárvore, com o estado alterado no lugar.
+static void full_search(int scheduled_ops, int current_makespan, SearchState *s,
+                        WorkerStats *ws, int tid, int prefix) {
+    if (interrupted) return;
+    ws->nodes++;
+
+    if (scheduled_ops == num_jobs * num_ops) {
+        ws->leaves++;
+        if (current_makespan < ws->best_makespan ||
+            (current_makespan == ws->best_makespan && prefix < ws->best_prefix)) {
+            ws->best_makespan = current_makespan;
+            ws->best_prefix = prefix;
+            memcpy(ws->best_schedule, s->schedule, sizeof(s->schedule));
+        }
+        return;
+    }
+
+    for (int j = 0; j < num_jobs; j++) {
+        int next_op = s->job_progress[j];
+        if (next_op >= num_ops) continue;
+
+        int m = ops_local[j][next_op].machine;
+        int saved_machine = s->machine_ready[m];
+        int saved_job = s->job_ready[j];
+        int end = apply_decision(s, j);
+        int partial = end > current_makespan ? end : current_makespan;
+
+        if (verbose_mode)
+            trace_branch(tid, scheduled_ops + 1, j, next_op, m, s->schedule[j][next_op].start, end, partial);
+
+        full_search(scheduled_ops + 1, partial, s, ws, tid, prefix);
+
+        s->job_progress[j]--;
+        s->job_ready[j] = saved_job;
+        s->machine_ready[m] = saved_machine;
+    }
+}
+
+// Retira o próximo prefixo do próprio intervalo.
+static int take_own(int tid) {
+    uint64_t r = atomic_load(&work_ranges[tid].range);
+    while (range_lo(r) < range_hi(r)) {
+        if (atomic_compare_exchange_weak(&work_ranges[tid].range, &r, pack_range(range_lo(r) + 1, range_hi(r))))
+            return (int)range_lo(r);
+    }
+    return -1;
+}
+
+// Rouba a metade final do intervalo de outra thread (primeiro no mesmo nó).
+static int steal(int tid, int threads) {
+    for (int k = 0; k < threads - 1; k++) {
+        int victim = victim_order[tid][k];
+        uint64_t r = atomic_load(&work_ranges[victim].range);
+        while (range_lo(r) < range_hi(r)) {
+            uint32_t lo = range_lo(r), hi = range_hi(r);
+            uint32_t half = (hi - lo + 1) / 2;
+            if (atomic_compare_exchange_weak(&work_ranges[victim].range, &r, pack_range(lo, hi - half))) {
+                atomic_store(&work_ranges[tid].range, pack_range(hi - half, hi));
+                worker_stats[tid].steals++;
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+void worker(int tid, int threads, int cur) {
+    static _Thread_local SearchState s;
+    WorkerStats *ws = &worker_stats[tid];
+
+    // Colocação: CPU do nó da thread, cópia local da instância e contadores
+    // inicializados aqui para as páginas ficarem nesse nó.
+    int node = numa_worker_node(&topology, tid, threads);
+    if (pin_threads) numa_pin_thread(numa_worker_cpu(&topology, tid, threads));
+    if (tid == 0 || numa_worker_node(&topology, tid - 1, threads) != node)
+        memcpy(replicas[node].ops, ops_backup, sizeof(ops_backup));
+    #pragma omp barrier
+    ops_local = replicas[node].ops;
+    ws->nodes = ws->leaves = ws->steals = 0;
+    ws->best_makespan = INT_MAX;
+    ws->best_prefix = INT_MAX;
+
+    for (;;) {
+        int p = take_own(tid);
+        if (p < 0) {
+            if (!steal(tid, threads)) break;
+            continue;
+        }
+        int makespan = replay_prefix(&s, prefix_paths[cur][p], prefix_depth);
+        full_search(prefix_depth, makespan, &s, ws, tid, p);
+    }
+}
+
+double measure_execution(int threads, int repeats) {
+    double total = 0.0;
+    for (int r = 0; r < repeats && !interrupted; r++) {
+        double t0 = omp_get_wtime();
+
+        int cur = build_prefixes(threads);
+        for (int t = 0; t < threads; t++) {
+            uint32_t lo = (uint32_t)((long long)num_prefixes * t / threads);
+            uint32_t hi = (uint32_t)((long long)num_prefixes * (t + 1) / threads);
+            atomic_store(&work_ranges[t].range, pack_range(lo, hi));
+            numa_victim_order(&topology, t, threads, victim_order[t]);
+        }
+
+        #pragma omp parallel num_threads(threads)
+        worker(omp_get_thread_num(), threads, cur);
+
+        // Redução final: ótimo (primeiro na ordem da árvore) e tamanho da árvore
+        best_makespan = INT_MAX;
+        int best_prefix = INT_MAX;
+        total_nodes = prefix_nodes;
+        total_leaves = 0;
+        for (int t = 0; t < threads; t++) {
+            WorkerStats *ws = &worker_stats[t];
+            total_nodes += ws->nodes;
+            total_leaves += ws->leaves;
+            if (ws->best_makespan < best_makespan ||
+                (ws->best_makespan == best_makespan && ws->best_prefix < best_prefix)) {
+                best_makespan = ws->best_makespan;
+                best_prefix = ws->best_prefix;
+                memcpy(best_schedule, ws->best_schedule, sizeof(best_schedule));
+            }
+        }
+
+        double t1 = omp_get_wtime();
+        total += (t1 - t0);
+    }
+    return total / repeats;
+}
+
+void write_output(const char *filename, double avg_time, int repeats, int threads, const char *input_name) {
+    FILE *fp = fopen(filename, "w");
+    if (!fp) { perror("Erro output"); exit(EXIT_FAILURE); }
+
+    static OutputWriter w;
+    writer_init(&w, fp);
+    writer_printf(&w, "# Solução Job-Shop: %s\n", input_name);
+    writer_printf(&w, "Melhor makespan: %d\n", best_makespan);
+    write_schedule_text(&w, SCHEDULE_VIEW(best_schedule, num_jobs, num_ops, num_machines));
+
+    writer_puts(&w, "\n# Árvore completa\n");
+    writer_printf(&w, "Nós explorados: %llu\n", total_nodes);
+    writer_printf(&w, "Folhas (calendários): %llu\n", total_leaves);
+    writer_printf(&w, "Prefixos: %d (profundidade %d)\n", num_prefixes, prefix_depth);
+    writer_printf(&w, "Nós NUMA: %d%s\n", topology.num_nodes, pin_threads ? " (threads fixas)" : "");
+    for (int t = 0; t < threads; t++)
+        writer_printf(&w, "Thread %2d: %llu nós | %llu folhas | %llu roubos\n", t,
+                      worker_stats[t].nodes, worker_stats[t].leaves, worker_stats[t].steals);
+    writer_printf(&w, "\n# Performance: Média de %.6f s em %d repetições com %d threads\n", avg_time, repeats, threads);
+    writer_flush(&w);
+    fclose(fp);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 5) {
+        fprintf(stderr, "Uso: %s input.jss output.txt threads repeticoes [--trace=F] [--trace-depth=N] [--trace-every=N] [--pin]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char *trace_file = NULL;
+    int trace_depth = 0;
+    unsigned long long trace_every = 1;
+    for (int a = 5; a < argc; a++) {
+        if (strncmp(argv[a], "--trace=", 8) == 0) trace_file = argv[a] + 8;
+        else if (strncmp(argv[a], "--trace-depth=", 14) == 0) trace_depth = atoi(argv[a] + 14);
+        else if (strncmp(argv[a], "--trace-every=", 14) == 0) trace_every = strtoull(argv[a] + 14, NULL, 10);
+        else if (strcmp(argv[a], "--pin") == 0) pin_threads = 1;
+        else { fprintf(stderr, "Opção desconhecida: %s\n", argv[a]); return EXIT_FAILURE; }
+    }
+
+    signal(SIGINT, handle_interrupt);
+    read_input(argv[1]);
+    numa_discover(&topology);
+
+    int threads = atoi(argv[3]);
+    int repeats = atoi(argv[4]);
+    if (threads < 1 || threads > MAX_THREADS || repeats < 1 || repeats > MAX_REPEATS) {
+        fprintf(stderr, "Parâmetros inválidos (threads 1..%d, repetições 1..%d)\n", MAX_THREADS, MAX_REPEATS);
+        return EXIT_FAILURE;
+    }
+
+    if (trace_file) {
+        if (trace_open(trace_file, trace_depth, trace_every) != 0) { perror("Erro trace"); return EXIT_FAILURE; }
+        verbose_mode = 1;
+    }
+
+    double avg_time = measure_execution(threads, repeats);
+    write_output(argv[2], avg_time, repeats, threads, argv[1]);
+    if (verbose_mode) trace_close();
+
+    printf("Melhor makespan: %d | Nós: %llu | Folhas: %llu | Tempo médio: %.6f s\n",
+           best_makespan, total_nodes, total_leaves, avg_time);
+    return interrupted ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -3,15 +3,25 @@
 
     ✅ Funcionalidades:
     - Percorre todas as alternativas (sem poda - sem branch-and-bound);
-    - Imprime todos os branches explorados (com info de job, operação, tempo, etc);
-    - Guarda esses branches num ficheiro "branches.txt";
+    - Regista todos os branches explorados (job, operação, máquina, tempos);
+    - Guarda esses branches em binário no ficheiro "branches.trc"
+      (ring buffer + thread de escrita, ver branch_trace.h);
     - Mantém o makespan ótimo encontrado;
 
     📄 Compilar:
-    gcc -Wall -g -o main_seq_verbose.exe mainSequentialFullSearchVerbose.c
+    gcc -Wall -g -pthread -o main_seq_verbose.exe mainSequentialFullSearch.c branch_trace.c
+    gcc -Wall -O2 -o trace_decode mainTraceDecode.c schedule_output.c
 
     🚀 Executar:
     ./main_seq_verbose.exe la01.jss output.txt 1
+    ./main_seq_verbose.exe la01.jss output.txt 1 --trace-depth=6 --trace-every=100
+    ./trace_decode branches.trc branches.txt
+
+    Opções:
+    --trace=FICHEIRO    ficheiro do trace (default branches.trc)
+    --trace-depth=N     só regista branches até à profundidade N
+    --trace-every=N     só regista 1 em cada N branches
+    --no-trace          desliga o registo de branches
 */
 
 #include <stdio.h>
@@ -20,6 +30,7 @@
 #include <limits.h>
 #include <signal.h>
 #include <time.h>
+#include "branch_trace.h"
 
 #define MAX_JOBS     10
 #define MAX_OPS      10
@@ -41,17 +52,13 @@ int best_makespan = INT_MAX;
 double program_start_time;
 volatile sig_atomic_t interrupted = 0;
 
-unsigned long long branch_count = 0;
-int verbose_mode = 1; // Define 1 para ativar output dos branches
-FILE *branch_log_fp = NULL; // ficheiro para guardar os branches
+int verbose_mode = 1; // Define 1 para ativar o registo dos branches
 
-// Tratador de interrupção (Ctrl+C)
+// Tratador de interrupção (Ctrl+C): só marca a flag (async-signal-safe);
+// a pesquisa termina e o main escreve o relatório e fecha o trace
 void handle_interrupt(int signum) {
+    (void)signum;
     interrupted = 1;
-    double elapsed = (clock() - program_start_time) / CLOCKS_PER_SEC;
-    fprintf(stderr, "\n[INTERRUPT] Melhor makespan: %d | Tempo: %.2f s\n", best_makespan, elapsed);
-    if (branch_log_fp) fclose(branch_log_fp);
-    exit(EXIT_FAILURE);
 }
 
 // Lê ficheiro de input .jss
@@ -124,14 +131,10 @@ void full_search(int scheduled_ops, int current_makespan,
         temp_job_ready[j] = end;
         temp_job_progress[j]++;
 
-        // Verbose: imprime o branch atual e salva no ficheiro
-        if (verbose_mode) {
-            branch_count++;
-            fprintf(branch_log_fp,
-                    "[Branch %llu | Profundidade %d] Job %d - Op %d | Máquina: %d | Início: %d | Fim: %d | Makespan parcial: %d\n",
-                    branch_count, scheduled_ops + 1, j, next_op, m, start, end,
-                    (end > current_makespan ? end : current_makespan));
-        }
+        // Verbose: regista o branch atual (registo binário, escrito em background)
+        if (verbose_mode)
+            trace_branch(0, scheduled_ops + 1, j, next_op, m, start, end,
+                         (end > current_makespan ? end : current_makespan));
 
         // Chamada recursiva
         full_search(scheduled_ops + 1,
@@ -190,10 +193,11 @@ void write_output(const char *filename, double avg_time, int repeats, const char
     fclose(fp);
 }
 
-// Mede o tempo de execução médio
-double measure_execution(int repeats) {
+// Mede o tempo de execução médio das repetições completas (*completed)
+double measure_execution(int repeats, int *completed) {
     double total = 0.0;
-    for (int r = 0; r < repeats; r++) {
+    *completed = 0;
+    for (int r = 0; r < repeats && !interrupted; r++) {
         best_makespan = INT_MAX;
         double t0 = (double) clock() / CLOCKS_PER_SEC;
 
@@ -203,35 +207,57 @@ double measure_execution(int repeats) {
         Operation current_schedule[MAX_JOBS][MAX_OPS] = {{{0}}};
 
         full_search(0, 0, job_progress, job_ready, machine_ready, current_schedule);
+        if (interrupted) break;   // repetição incompleta: fora da média
 
         double t1 = (double) clock() / CLOCKS_PER_SEC;
         total += (t1 - t0);
+        (*completed)++;
     }
-    return total / repeats;
+    return *completed > 0 ? total / *completed : 0.0;
 }
 
 int main(int argc, char *argv[]) {
     if (argc < 4) {
-        fprintf(stderr, "Uso: %s input.jss output.txt repeticoes\n", argv[0]);
+        fprintf(stderr, "Uso: %s input.jss output.txt repeticoes [--trace=F] [--trace-depth=N] [--trace-every=N] [--no-trace]\n", argv[0]);
         return EXIT_FAILURE;
     }
 
+    const char *trace_file = "branches.trc";
+    int trace_depth = 0;
+    unsigned long long trace_every = 1;
+    for (int a = 4; a < argc; a++) {
+        if (strncmp(argv[a], "--trace=", 8) == 0) trace_file = argv[a] + 8;
+        else if (strncmp(argv[a], "--trace-depth=", 14) == 0) trace_depth = atoi(argv[a] + 14);
+        else if (strncmp(argv[a], "--trace-every=", 14) == 0) trace_every = strtoull(argv[a] + 14, NULL, 10);
+        else if (strcmp(argv[a], "--no-trace") == 0) verbose_mode = 0;
+        else { fprintf(stderr, "Opção desconhecida: %s\n", argv[a]); return EXIT_FAILURE; }
+    }
+
     signal(SIGINT, handle_interrupt);
     program_start_time = clock();
     read_input(argv[1]);
 
-    // Abre ficheiro para branches
-    branch_log_fp = fopen("branches.txt", "w");
-    if (!branch_log_fp) { perror("Erro branches.txt"); exit(EXIT_FAILURE); }
-
     int repeats = atoi(argv[3]);
     if (repeats < 1 || repeats > MAX_REPEATS) {
         fprintf(stderr, "Repetições inválidas\n"); return EXIT_FAILURE;
     }
 
-    double avg_time = measure_execution(repeats);
-    write_output(argv[2], avg_time, repeats, argv[1]);
+    // Abre o trace dos branches (thread de escrita em background)
+    if (verbose_mode && trace_open(trace_file, trace_depth, trace_every) != 0) {
+        perror("Erro trace"); exit(EXIT_FAILURE);
+    }
 
-    fclose(branch_log_fp);
-    return EXIT_SUCCESS;
+    int completed;
+    double avg_time = measure_execution(repeats, &completed);
+    if (interrupted)
+        fprintf(stderr, "\n[INTERRUPT] Melhor makespan: %d | Tempo: %.2f s\n",
+                best_makespan, (clock() - program_start_time) / CLOCKS_PER_SEC);
+    write_output(argv[2], avg_time, completed, argv[1]);
+
+    if (verbose_mode) {
+        trace_close();
+        if (trace_stalls() > 0)
+            fprintf(stderr, "Trace: %llu esperas por buffer cheio\n", (unsigned long long)trace_stalls());
+    }
+    return interrupted ? EXIT_FAILURE : EXIT_SUCCESS;
 }
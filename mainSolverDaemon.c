@@ -0,0 +1,671 @@
+/*
+    Solver daemon: a long-running local service in front of the solvers.
+
+    Clients connect to a Unix domain socket and send an instance in the
+    read_input() format (.jss text) with a priority and a time budget. The
+    daemon keeps a priority queue of requests and runs them on a persistent
+    worker pool (worker_pool.h): every pool task takes the most urgent
+    request, so the pool size is the number of concurrent solves. Each
+    solve runs the solver binary (mainV6BranchSave.c by default) in its own
+    work directory; at the end of the budget the solver gets SIGINT and
+    answers with its best schedule so far (interrupted_output.txt).
+
+    While a request runs, the daemon streams the solver's progress lines
+    ("[Incumbent] 930", "Best=...", "UB=..." / "LB=...") back as INCUMBENT
+    and BOUND events. The result is the solver's write_output() file.
+
+    Results are cached on disk, keyed by a hash of the instance's numbers
+    (whitespace and the file name do not matter), the solver binary, the
+    thread count and the solver options. An optimal result (only when the
+    solver's output says the search proved it) answers every later request
+    with the same key at once; a complete one (the solver stopped on its
+    own without a proof) answers requests with no budget or at least its
+    run time; a budget-limited one (best makespan and lower bound) answers
+    requests with the same or a smaller budget.
+
+    Protocol (text lines):
+        client: SOLVE [priority=N] [budget=SECONDS] [threads=N] [--solver-option ...]
+                <instance lines>
+                END
+        daemon: QUEUED <id> position <n> | CACHED <id>
+                STARTED <id> waited <s>
+                INCUMBENT <makespan> <elapsed>
+                BOUND <lower bound> <elapsed>
+                RESULT <id> <optimal|complete|budget|error> makespan <m> lower_bound <lb> time <s>
+                <write_output() lines>
+                END
+        client: STATS   ->   STATS queued .. running .. solved .. cache_hits .. cache_misses ..
+
+    Higher priority first, then arrival order; budget=0 runs to optimality.
+    A client has DAEMON_IO_TIMEOUT_SEC for each read and write of its
+    request, so a stalled one cannot hold up the accept loop.
+
+    📄 Compilar:
+    gcc -Wall -O2 -o solver_daemon mainSolverDaemon.c worker_pool.c child_runner.c -pthread
+    gcc -fopenmp -Wall -O2 -o main_v6 mainV6BranchSave.c par_runtime.c worker_pool.c numa_topology.c schedule_output.c schedule_check.c propagation.c arena.c shape_kernels.c event_stream.c -pthread
+
+    🚀 Executar:
+    ./solver_daemon --socket=/tmp/jobshop.sock --workers=2 --cache=solver_cache --solver=./main_v6
+    ./solver_daemon --connect=/tmp/jobshop.sock --budget=10 --priority=1 Matrizes/ft10.jss --order=est
+    ./solver_daemon --connect=/tmp/jobshop.sock --stats
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include "jobshop.h"
+#include "worker_pool.h"
+#include "child_runner.h"
+
+#define DAEMON_MAX_PENDING  64                 // queued + running requests
+#define DAEMON_MAX_PAYLOAD  (256 << 10)        // instance text
+#define DAEMON_MAX_OPTIONS  16                 // solver options per request
+#define DAEMON_OPTION_LEN   64
+#define DAEMON_LINE         4096
+#define DAEMON_RESULT_MAX   (1 << 20)          // solver output file
+#define DAEMON_GRACE_SEC    10                 // after SIGINT, before SIGKILL
+#define DAEMON_IO_TIMEOUT_SEC 5                // per socket read / write of a client
+#define DAEMON_PROOF_LINE   "Optimality: proven"   // solver output of a completed proof
+
+typedef struct {
+    int id, priority, threads, fd;
+    double budget;                             // seconds, 0: until optimal
+    double submitted;
+    uint64_t key;                              // instance, solver, threads and options
+    int num_options;
+    char options[DAEMON_MAX_OPTIONS][DAEMON_OPTION_LEN];
+    size_t payload_bytes;
+    char payload[DAEMON_MAX_PAYLOAD];
+} Request;
+
+typedef struct {
+    char status[16];                           // optimal | complete | budget | error
+    int makespan, lower_bound;
+    double budget, time;
+} ResultInfo;
+
+// ================== Shared State ==================
+const char *socket_path = "/tmp/jobshop.sock";
+char solver_path[PATH_MAX] = "./main_v6";
+char cache_dir[1024] = "solver_cache";
+int num_workers = 1;
+
+Request requests[DAEMON_MAX_PENDING];
+int free_slots[DAEMON_MAX_PENDING], num_free;
+int heap[DAEMON_MAX_PENDING], heap_size;     // slots ordered by (priority desc, id asc)
+int next_id = 1, running, solved, cache_hits, cache_misses;
+pthread_mutex_t queue_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;   // writers (the main thread only reads)
+static WorkerPool pool;
+volatile sig_atomic_t stopping = 0;
+
+double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void handle_stop(int signum) {
+    (void)signum;
+    stopping = 1;
+}
+
+// ================== Socket I/O ==================
+typedef struct {
+    int fd;
+    size_t len, pos;
+    char buf[DAEMON_LINE];
+} LineReader;
+
+// One line without the newline; -1 at end of stream (or a line too long).
+int read_line(LineReader *r, char *line, size_t size) {
+    size_t n = 0;
+    for (;;) {
+        if (r->pos == r->len) {
+            ssize_t got = read(r->fd, r->buf, sizeof(r->buf));
+            if (got < 0 && errno == EINTR) continue;
+            if (got <= 0) return n > 0 ? (line[n] = '\0', 0) : -1;
+            r->len = (size_t)got;
+            r->pos = 0;
+        }
+        char c = r->buf[r->pos++];
+        if (c == '\n') break;
+        if (c == '\r') continue;
+        if (n + 1 >= size) return -1;
+        line[n++] = c;
+    }
+    line[n] = '\0';
+    return 0;
+}
+
+// Writes everything; a client that went away only makes this fail.
+int send_all(int fd, const char *data, size_t bytes) {
+    while (bytes > 0) {
+        ssize_t n = send(fd, data, bytes, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        data += n;
+        bytes -= (size_t)n;
+    }
+    return 0;
+}
+
+int send_line(int fd, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+int send_line(int fd, const char *fmt, ...) {
+    char line[DAEMON_LINE];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(line, sizeof(line) - 1, fmt, ap);
+    va_end(ap);
+    if (n < 0) return -1;
+    if (n > (int)sizeof(line) - 2) n = (int)sizeof(line) - 2;
+    line[n++] = '\n';
+    return send_all(fd, line, (size_t)n);
+}
+
+// ================== Instances and Cache ==================
+/*
+    Checks that the payload is a read_input() instance (num_jobs num_machines,
+    then machine/duration pairs) and hashes its numbers (FNV-1a, 64 bits),
+    so the key ignores layout and comments after the data.
+*/
+int hash_instance(const char *text, uint64_t *hash) {
+    uint64_t h = 1469598103934665603ULL;
+    const char *p = text;
+    long values[2];
+    int count = 0, needed = 2;
+    while (count < needed) {
+        char *end;
+        long v = strtol(p, &end, 10);
+        if (end == p || v < 0) return -1;
+        if (count < 2) {
+            values[count] = v;
+            if (count == 1) {
+                if (values[0] < 1 || values[1] < 1 || values[1] > JSS_MAX_MACHINES ||
+                    values[0] * values[1] > JSS_MAX_OPERATIONS) return -1;
+                needed = 2 + 2 * (int)(values[0] * values[1]);
+            }
+        }
+        else if ((count - 2) % 2 == 0 && v >= values[1]) return -1;   // machine index
+        for (int b = 0; b < 8; b++) {
+            h ^= (uint64_t)(v >> (8 * b)) & 0xFF;
+            h *= 1099511628211ULL;
+        }
+        p = end;
+        count++;
+    }
+    *hash = h;
+    return 0;
+}
+
+static uint64_t hash_bytes(uint64_t h, const void *data, size_t bytes) {
+    const unsigned char *p = data;
+    for (size_t b = 0; b < bytes; b++) {
+        h ^= p[b];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// Cache key: the instance hash extended with everything that changes the result.
+uint64_t request_key(uint64_t instance_hash, const Request *r) {
+    uint64_t h = hash_bytes(instance_hash, solver_path, strlen(solver_path) + 1);
+    h = hash_bytes(h, &r->threads, sizeof(r->threads));
+    for (int o = 0; o < r->num_options; o++)
+        h = hash_bytes(h, r->options[o], strlen(r->options[o]) + 1);
+    return h;
+}
+
+void cache_path(char *path, size_t size, uint64_t hash) {
+    snprintf(path, size, "%s/%016llx.txt", cache_dir, (unsigned long long)hash);
+}
+
+// Cache file: "# cache status=.. makespan=.. lower_bound=.. budget=.. time=.." then the result.
+int cache_lookup(uint64_t hash, double budget, ResultInfo *info, char *result, size_t size) {
+    char path[PATH_MAX];
+    cache_path(path, sizeof(path), hash);
+    FILE *fp = fopen(path, "r");
+    if (!fp) return -1;
+    int ok = fscanf(fp, "# cache status=%15s makespan=%d lower_bound=%d budget=%lf time=%lf\n",
+                    info->status, &info->makespan, &info->lower_bound, &info->budget, &info->time) == 5;
+    size_t n = ok ? fread(result, 1, size - 1, fp) : 0;
+    fclose(fp);
+    result[n] = '\0';
+    if (!ok) return -1;
+    if (strcmp(info->status, "optimal") == 0) return 0;
+    if (strcmp(info->status, "complete") == 0 && (budget == 0 || budget >= info->time)) return 0;
+    if (strcmp(info->status, "budget") == 0 && budget > 0 && budget <= info->budget) return 0;
+    return -1;
+}
+
+void cache_store(uint64_t hash, const ResultInfo *info, const char *result) {
+    char path[PATH_MAX], tmp[PATH_MAX + 16];
+    ResultInfo old;
+    static char old_result[DAEMON_RESULT_MAX];
+    cache_path(path, sizeof(path), hash);
+    pthread_mutex_lock(&cache_lock);
+    // Never replace an optimal entry, nor a budget entry by a shorter run
+    if (cache_lookup(hash, info->budget > 0 ? info->budget : 1e300, &old, old_result, sizeof(old_result)) == 0 &&
+        (strcmp(old.status, "optimal") == 0 || strcmp(info->status, "optimal") != 0)) {
+        pthread_mutex_unlock(&cache_lock);
+        return;
+    }
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE *fp = fopen(tmp, "w");
+    if (!fp) { pthread_mutex_unlock(&cache_lock); return; }
+    fprintf(fp, "# cache status=%s makespan=%d lower_bound=%d budget=%.3f time=%.3f\n",
+            info->status, info->makespan, info->lower_bound, info->budget, info->time);
+    fputs(result, fp);
+    if (fclose(fp) == 0) rename(tmp, path);   // readers see the old file or the whole new one
+    else unlink(tmp);
+    pthread_mutex_unlock(&cache_lock);
+}
+
+// ================== Priority Queue ==================
+static int before(int a, int b) {
+    if (requests[a].priority != requests[b].priority) return requests[a].priority > requests[b].priority;
+    return requests[a].id < requests[b].id;
+}
+
+static void heap_push(int slot) {
+    int i = heap_size++;
+    heap[i] = slot;
+    while (i > 0 && before(heap[i], heap[(i - 1) / 2])) {
+        int parent = (i - 1) / 2, t = heap[i];
+        heap[i] = heap[parent]; heap[parent] = t;
+        i = parent;
+    }
+}
+
+static int heap_pop(void) {
+    int top = heap[0];
+    heap[0] = heap[--heap_size];
+    for (int i = 0; ; ) {
+        int l = 2 * i + 1, r = l + 1, m = i;
+        if (l < heap_size && before(heap[l], heap[m])) m = l;
+        if (r < heap_size && before(heap[r], heap[m])) m = r;
+        if (m == i) break;
+        int t = heap[i]; heap[i] = heap[m]; heap[m] = t;
+        i = m;
+    }
+    return top;
+}
+
+// ================== Solving ==================
+// Progress line of the solver -> INCUMBENT / BOUND events (monotone).
+void forward_progress(Request *r, const char *line, double elapsed, int *best, int *bound) {
+    const char *p;
+    int value;
+    if ((sscanf(line, "[Incumbent] %d", &value) == 1 ||
+         ((p = strstr(line, "Best=")) && sscanf(p, "Best=%d", &value) == 1) ||
+         ((p = strstr(line, "UB=")) && sscanf(p, "UB=%d", &value) == 1)) && value < *best) {
+        *best = value;
+        send_line(r->fd, "INCUMBENT %d %.3f", value, elapsed);
+    }
+    if ((p = strstr(line, "LB=")) && sscanf(p, "LB=%d", &value) == 1 && value > *bound) {
+        *bound = value;
+        send_line(r->fd, "BOUND %d %.3f", value, elapsed);
+    }
+}
+
+size_t read_file(const char *path, char *buf, size_t size) {
+    FILE *fp = fopen(path, "r");
+    if (!fp) { buf[0] = '\0'; return 0; }
+    size_t n = fread(buf, 1, size - 1, fp);
+    fclose(fp);
+    buf[n] = '\0';
+    return n;
+}
+
+typedef struct {
+    Request *r;
+    ResultInfo *info;
+    int best, bound;
+} SolveProgress;
+
+static void take_progress_line(const char *line, double elapsed, void *arg) {
+    SolveProgress *sp = arg;
+    forward_progress(sp->r, line, elapsed, &sp->best, &sp->bound);
+}
+
+// SIGINT at the end of the budget, on shutdown or when the client hangs up.
+static int should_stop(double elapsed, void *arg) {
+    SolveProgress *sp = arg;
+    struct pollfd pfd = { sp->r->fd, POLLRDHUP, 0 };
+    int client_gone = poll(&pfd, 1, 0) > 0 && (pfd.revents & (POLLRDHUP | POLLHUP | POLLERR));
+    if (!stopping && !client_gone && (sp->r->budget == 0 || elapsed < sp->r->budget)) return 0;
+    if (elapsed < sp->r->budget || sp->r->budget == 0) sp->info->budget = 0;   // cut short: not a budget result
+    return 1;
+}
+
+/*
+    Runs the solver on the request in a fresh work directory and streams its
+    progress. Returns the result text in result (write_output() format, or
+    interrupted_output.txt when the budget ran out).
+*/
+void solve(Request *r, ResultInfo *info, char *result, size_t size) {
+    char dir[64], path[PATH_MAX];
+    strcpy(info->status, "error");
+    info->makespan = INT_MAX;
+    info->lower_bound = 0;
+    info->budget = r->budget;
+    info->time = 0;
+    result[0] = '\0';
+    if (child_make_dir(dir, sizeof(dir), "jobshop_daemon") != 0) return;
+    snprintf(path, sizeof(path), "%s/input.jss", dir);
+    FILE *fp = fopen(path, "w");
+    if (fp) { fwrite(r->payload, 1, r->payload_bytes, fp); fclose(fp); }
+
+    char threads[16], *argv[6 + DAEMON_MAX_OPTIONS];
+    int argc = 0;
+    snprintf(threads, sizeof(threads), "%d", r->threads);
+    argv[argc++] = solver_path;
+    argv[argc++] = "input.jss";
+    argv[argc++] = "output.txt";
+    argv[argc++] = threads;
+    argv[argc++] = "1";
+    for (int o = 0; o < r->num_options; o++) argv[argc++] = r->options[o];
+    argv[argc] = NULL;
+    SolveProgress sp = { r, info, INT_MAX, 0 };
+    ChildHooks hooks = { take_progress_line, should_stop, &sp, DAEMON_GRACE_SEC };
+    ChildResult child;
+    if (child_run(dir, argv, &hooks, &child) != 0) {
+        child_remove_dir(dir);
+        return;
+    }
+    info->time = child.wall;
+
+    snprintf(path, sizeof(path), "%s/output.txt", dir);
+    if (WIFEXITED(child.status) && WEXITSTATUS(child.status) == 0 && read_file(path, result, size) > 0) {
+        const char *p = strstr(result, "Best makespan:");
+        if (p) sscanf(p, "Best makespan: %d", &info->makespan);
+        if (strstr(result, DAEMON_PROOF_LINE)) {
+            strcpy(info->status, "optimal");
+            info->lower_bound = info->makespan;
+        }
+        else {   // a heuristic that stopped on its own
+            strcpy(info->status, "complete");
+            info->lower_bound = sp.bound;
+        }
+    }
+    else {
+        snprintf(path, sizeof(path), "%s/interrupted_output.txt", dir);
+        if (read_file(path, result, size) > 0) {
+            strcpy(info->status, "budget");
+            const char *p = strstr(result, "Best makespan:");
+            if (p) sscanf(p, "Best makespan: %d", &info->makespan);
+            p = strstr(result, "Lower bound:");
+            if (p) sscanf(p, "Lower bound: %d", &info->lower_bound);
+            if (sp.bound > info->lower_bound) info->lower_bound = sp.bound;
+        }
+    }
+    child_remove_dir(dir);
+}
+
+void send_result(const Request *r, const ResultInfo *info, const char *result) {
+    send_line(r->fd, "RESULT %d %s makespan %d lower_bound %d time %.3f",
+              r->id, info->status, info->makespan == INT_MAX ? -1 : info->makespan, info->lower_bound, info->time);
+    send_all(r->fd, result, strlen(result));
+    if (result[0] && result[strlen(result) - 1] != '\n') send_all(r->fd, "\n", 1);
+    send_line(r->fd, "END");
+}
+
+// Pool task: one per queued request; takes whichever request is most urgent now.
+void run_next_request(void *arg, int worker) {
+    (void)arg; (void)worker;
+    static char results[POOL_MAX_WORKERS + 1][DAEMON_RESULT_MAX];
+    char *result = results[worker];
+
+    pthread_mutex_lock(&queue_lock);
+    int slot = heap_pop();
+    running++;
+    pthread_mutex_unlock(&queue_lock);
+
+    Request *r = &requests[slot];
+    ResultInfo info;
+    if (stopping) {
+        send_line(r->fd, "CANCELLED %d", r->id);
+    }
+    else {
+        send_line(r->fd, "STARTED %d waited %.3f", r->id, now() - r->submitted);
+        solve(r, &info, result, DAEMON_RESULT_MAX);
+        if (strcmp(info.status, "optimal") == 0 ||
+            (strcmp(info.status, "complete") == 0 && info.makespan != INT_MAX) ||
+            (strcmp(info.status, "budget") == 0 && info.budget > 0))
+            cache_store(r->key, &info, result);
+        send_result(r, &info, result);
+    }
+    close(r->fd);
+
+    pthread_mutex_lock(&queue_lock);
+    running--;
+    solved++;
+    free_slots[num_free++] = slot;
+    pthread_mutex_unlock(&queue_lock);
+}
+
+// ================== Requests ==================
+/*
+    Reads one request from a new connection. Answers STATS and cache hits
+    directly; queues the rest (the pool task closes the connection).
+*/
+void handle_connection(int fd) {
+    static LineReader reader;
+    static char line[DAEMON_LINE];
+    static Request incoming;
+    static char result[DAEMON_RESULT_MAX];
+    reader.fd = fd;
+    reader.len = reader.pos = 0;
+
+    if (read_line(&reader, line, sizeof(line)) < 0) { close(fd); return; }
+    if (strcmp(line, "STATS") == 0) {
+        pthread_mutex_lock(&queue_lock);
+        send_line(fd, "STATS queued %d running %d solved %d cache_hits %d cache_misses %d workers %d",
+                  heap_size, running, solved, cache_hits, cache_misses, num_workers);
+        pthread_mutex_unlock(&queue_lock);
+        close(fd);
+        return;
+    }
+
+    Request *r = &incoming;
+    r->priority = 0;
+    r->budget = 0;
+    r->threads = 1;
+    r->num_options = 0;
+    r->payload_bytes = 0;
+    char *save, *token = strtok_r(line, " \t", &save);
+    if (!token || strcmp(token, "SOLVE") != 0) { send_line(fd, "ERROR expected SOLVE or STATS"); close(fd); return; }
+    while ((token = strtok_r(NULL, " \t", &save))) {
+        if (strncmp(token, "priority=", 9) == 0) r->priority = atoi(token + 9);
+        else if (strncmp(token, "budget=", 7) == 0) r->budget = atof(token + 7);
+        else if (strncmp(token, "threads=", 8) == 0) r->threads = atoi(token + 8);
+        else if (strncmp(token, "--", 2) == 0 && !strchr(token, '/') &&
+                 strlen(token) < DAEMON_OPTION_LEN && r->num_options < DAEMON_MAX_OPTIONS)
+            strcpy(r->options[r->num_options++], token);   // no paths: solvers only write in their work directory
+        else { send_line(fd, "ERROR bad argument %s", token); close(fd); return; }
+    }
+    if (r->threads < 1 || r->budget < 0) { send_line(fd, "ERROR bad threads or budget"); close(fd); return; }
+
+    for (;;) {
+        if (read_line(&reader, line, sizeof(line)) < 0) { send_line(fd, "ERROR missing END"); close(fd); return; }
+        if (strcmp(line, "END") == 0) break;
+        size_t n = strlen(line);
+        if (r->payload_bytes + n + 2 > DAEMON_MAX_PAYLOAD) { send_line(fd, "ERROR instance too large"); close(fd); return; }
+        memcpy(r->payload + r->payload_bytes, line, n);
+        r->payload_bytes += n;
+        r->payload[r->payload_bytes++] = '\n';
+    }
+    r->payload[r->payload_bytes] = '\0';
+    uint64_t instance_hash;
+    if (hash_instance(r->payload, &instance_hash) != 0) { send_line(fd, "ERROR not a job-shop instance"); close(fd); return; }
+    r->key = request_key(instance_hash, r);
+
+    pthread_mutex_lock(&queue_lock);
+    r->id = next_id++;
+    pthread_mutex_unlock(&queue_lock);
+
+    ResultInfo info;
+    if (cache_lookup(r->key, r->budget, &info, result, sizeof(result)) == 0) {
+        pthread_mutex_lock(&queue_lock);
+        cache_hits++;
+        pthread_mutex_unlock(&queue_lock);
+        r->fd = fd;
+        send_line(fd, "CACHED %d", r->id);
+        send_result(r, &info, result);
+        close(fd);
+        return;
+    }
+
+    pthread_mutex_lock(&queue_lock);
+    cache_misses++;
+    if (num_free == 0) {
+        pthread_mutex_unlock(&queue_lock);
+        send_line(fd, "ERROR queue full");
+        close(fd);
+        return;
+    }
+    int slot = free_slots[--num_free];
+    Request *q = &requests[slot];
+    memcpy(q, r, offsetof(Request, payload));
+    memcpy(q->payload, r->payload, r->payload_bytes + 1);
+    q->fd = fd;
+    q->submitted = now();
+    heap_push(slot);
+    int position = heap_size;
+    pthread_mutex_unlock(&queue_lock);
+
+    send_line(fd, "QUEUED %d position %d", q->id, position);
+    pool_submit(&pool, run_next_request, NULL);
+}
+
+int serve(void) {
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    if (listen_fd < 0 || strlen(socket_path) >= sizeof(addr.sun_path)) { perror("socket"); return EXIT_FAILURE; }
+    strcpy(addr.sun_path, socket_path);
+    unlink(socket_path);
+    if (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(listen_fd, 64) != 0) {
+        perror("bind");
+        return EXIT_FAILURE;
+    }
+    mkdir(cache_dir, 0755);
+    for (int s = 0; s < DAEMON_MAX_PENDING; s++) free_slots[s] = DAEMON_MAX_PENDING - 1 - s;
+    num_free = DAEMON_MAX_PENDING;
+
+    // Workers inherit a mask without SIGINT/SIGTERM: the signal reaches the
+    // main thread and interrupts accept() (no SA_RESTART)
+    sigset_t stop_signals;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stop_signals, NULL);
+    int started = pool_init(&pool, num_workers);
+    pthread_sigmask(SIG_UNBLOCK, &stop_signals, NULL);
+    if (started != 0) { fprintf(stderr, "Could not start the worker pool\n"); return EXIT_FAILURE; }
+    struct sigaction sa = { .sa_handler = handle_stop };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+    printf("Listening on %s | %d workers | solver %s | cache %s\n", socket_path, num_workers, solver_path, cache_dir);
+    fflush(stdout);
+
+    const struct timeval io_timeout = { DAEMON_IO_TIMEOUT_SEC, 0 };
+    while (!stopping) {
+        int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) continue;   // EINTR on shutdown
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &io_timeout, sizeof(io_timeout));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &io_timeout, sizeof(io_timeout));
+        handle_connection(fd);
+    }
+    // Queued requests are cancelled, running solves get their SIGINT
+    pool_wait(&pool);
+    pool_destroy(&pool);
+    close(listen_fd);
+    unlink(socket_path);
+    printf("Stopped | solved %d | cache hits %d / misses %d\n", solved, cache_hits, cache_misses);
+    return EXIT_SUCCESS;
+}
+
+// ================== Client ==================
+int client(const char *path, int argc, char *argv[]) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) { perror("connect"); return EXIT_FAILURE; }
+
+    static char request[DAEMON_LINE];
+    const char *instance = NULL;
+    int stats = 0;
+    size_t n = (size_t)snprintf(request, sizeof(request), "SOLVE");
+    for (int a = 0; a < argc && n < sizeof(request); a++) {
+        if (strcmp(argv[a], "--stats") == 0) stats = 1;
+        else if (strncmp(argv[a], "--priority=", 11) == 0 || strncmp(argv[a], "--budget=", 9) == 0 ||
+                 strncmp(argv[a], "--threads=", 10) == 0)
+            n += (size_t)snprintf(request + n, sizeof(request) - n, " %s", argv[a] + 2);
+        else if (!instance && strncmp(argv[a], "--", 2) != 0) instance = argv[a];
+        else n += (size_t)snprintf(request + n, sizeof(request) - n, " %s", argv[a]);
+    }
+    if (stats) send_line(fd, "STATS");
+    else {
+        static char payload[DAEMON_MAX_PAYLOAD];
+        if (!instance || read_file(instance, payload, sizeof(payload)) == 0) {
+            fprintf(stderr, "Cannot read instance %s\n", instance ? instance : "(none)");
+            return EXIT_FAILURE;
+        }
+        send_line(fd, "%s", request);
+        send_all(fd, payload, strlen(payload));
+        send_line(fd, "%s", payload[strlen(payload) - 1] == '\n' ? "END" : "\nEND");
+    }
+
+    char buf[DAEMON_LINE];
+    ssize_t got;
+    while ((got = read(fd, buf, sizeof(buf))) > 0) fwrite(buf, 1, (size_t)got, stdout);
+    close(fd);
+    return EXIT_SUCCESS;
+}
+
+// ================== Main ==================
+int main(int argc, char *argv[]) {
+    for (int a = 1; a < argc; a++) {
+        if (strncmp(argv[a], "--connect=", 10) == 0) return client(argv[a] + 10, argc - a - 1, argv + a + 1);
+        if (strncmp(argv[a], "--socket=", 9) == 0) socket_path = argv[a] + 9;
+        else if (strncmp(argv[a], "--workers=", 10) == 0) num_workers = atoi(argv[a] + 10);
+        else if (strncmp(argv[a], "--cache=", 8) == 0) snprintf(cache_dir, sizeof(cache_dir), "%s", argv[a] + 8);
+        else if (strncmp(argv[a], "--solver=", 9) == 0) snprintf(solver_path, sizeof(solver_path), "%s", argv[a] + 9);
+        else {
+            fprintf(stderr, "Usage: %s [--socket=PATH] [--workers=N] [--cache=DIR] [--solver=BINARY]\n"
+                            "       %s --connect=PATH [--priority=N] [--budget=SEC] [--threads=N] instance.jss [solver options]\n"
+                            "       %s --connect=PATH --stats\n", argv[0], argv[0], argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (num_workers < 1 || num_workers > POOL_MAX_WORKERS) {
+        fprintf(stderr, "Invalid number of workers.\n");
+        return EXIT_FAILURE;
+    }
+    char resolved[PATH_MAX];
+    if (!realpath(solver_path, resolved) || access(resolved, X_OK) != 0) {
+        fprintf(stderr, "Solver not found: %s\n", solver_path);
+        return EXIT_FAILURE;
+    }
+    strcpy(solver_path, resolved);   // the solver runs in its work directory
+    return serve();
+}
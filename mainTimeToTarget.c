@@ -0,0 +1,496 @@
+/*
+    Time-to-target benchmark across solvers and instances.
+
+    Average runtime says little when two solvers stop at different
+    makespans. This driver runs every solver many times (a different seed
+    per run) on every instance and records, for each run, when it first
+    reached each target makespan: reference * (1 + p/100) for every p in
+    --targets (0 = the reference itself).
+
+    Solvers are command templates run as child processes, one at a time so
+    runs never compete for cores:
+        {instance}  instance path     {output}   output file in the run's work directory
+        {seed}      seed of the run   {timeout}  --timeout in seconds
+    The driver timestamps every "[Incumbent] N" line (V6, GRASP, annealing)
+    and "Best makespan: N" line the solver prints, and reads the output
+    file at exit (first line a number, or a "Best makespan:" line). A solver
+    without progress lines (shifting bottleneck, list schedule) reaches its
+    targets at its exit time. At the timeout the solver gets SIGINT (V6
+    then writes interrupted_output.txt), SIGKILL 5 seconds later.
+
+    The reference of an instance is its value in --reference=FILE (lines
+    "ft10 930", by file name without .jss) or, when absent, the best
+    makespan any run found.
+
+    Results (--out=PREFIX, default ttt):
+    - PREFIX_runs.csv     one row per run: final makespan, wall time, time to every target
+    - PREFIX_ttt.csv      empirical TTT distributions: the sorted times of the
+                          runs that reached the target, i-th with probability
+                          (i - 0.5) / runs (runs that missed it count in runs,
+                          so the curve ends at the success rate)
+    - PREFIX_profile.csv  performance profiles per target over all instances:
+                          metric ERT = (time of all runs, misses at their full
+                          wall time) / successful runs; for every solver the
+                          fraction of instances with ERT <= tau * best ERT
+    and a summary table on stdout.
+
+    📄 Compilar:
+    gcc -Wall -O2 -o ttt_bench mainTimeToTarget.c child_runner.c -lm
+
+    🚀 Executar:
+    ./ttt_bench --runs=20 --timeout=60 --targets=0,1,5 --out=ttt \
+        "--solver=bnb=./main_v6 {instance} {output} 4 1 --order=est --lds" \
+        "--solver=sb=trabalho/mainV4 {instance} {output} 4 1" \
+        "--solver=list=trabalho/mainV3Optimized {instance} {output} 4 1" \
+        "--solver=grasp=trabalho/mainGrasp {instance} {output} 4 2000 0.5 {seed}" \
+        "--solver=sa=trabalho/mainAnnealing {instance} {output} 4 {timeout} 1 20 {seed}" \
+        Matrizes/
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <signal.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/wait.h>
+#include "child_runner.h"
+
+#define TTT_MAX_SOLVERS   8
+#define TTT_MAX_INSTANCES 64
+#define TTT_MAX_RUNS      200
+#define TTT_MAX_TARGETS   8
+#define TTT_MAX_POINTS    (1 << 20)   // incumbent improvements over all runs
+#define TTT_MAX_ARGS      32
+#define TTT_COMMAND_LEN   1024
+#define TTT_LINE          4096
+#define TTT_GRACE_SEC     5
+
+typedef enum { RUN_DONE, RUN_TIMEOUT, RUN_ERROR } RunStatus;
+const char *status_names[] = { "done", "timeout", "error" };
+
+typedef struct {
+    char name[32];
+    char command[TTT_COMMAND_LEN];
+} Solver;
+
+typedef struct {
+    double time;                 // seconds since the solver started
+    int makespan;
+} Point;
+
+typedef struct {
+    int first_point, num_points; // improvements, in points[]
+    int final;                   // INT_MAX: no schedule
+    double wall;
+    RunStatus status;
+} Run;
+
+Solver solvers[TTT_MAX_SOLVERS];
+int num_solvers;
+char instances[TTT_MAX_INSTANCES][PATH_MAX];
+char instance_names[TTT_MAX_INSTANCES][64];
+int num_instances;
+int reference[TTT_MAX_INSTANCES];
+int reference_given[TTT_MAX_INSTANCES];
+double targets[TTT_MAX_TARGETS] = { 0.0, 1.0, 5.0 };
+int num_targets = 3;
+int num_runs = 10;
+double timeout_sec = 60.0;
+unsigned long long base_seed = 1;
+
+Run runs[TTT_MAX_INSTANCES][TTT_MAX_SOLVERS][TTT_MAX_RUNS];
+Point points[TTT_MAX_POINTS];
+int num_points;
+
+// ================== Solver Runs ==================
+// Makespan reported on a progress or result line; -1 if none.
+int parse_makespan(const char *line) {
+    const char *p;
+    int value;
+    if ((p = strstr(line, "[Incumbent] ")) && sscanf(p + 12, "%d", &value) == 1) return value;
+    if ((p = strstr(line, "Best makespan")) && (p = strchr(p, ':')) && sscanf(p + 1, "%d", &value) == 1) return value;
+    return -1;
+}
+
+// Makespan in a result file: a number on the first line, or a "Best makespan:" line.
+int read_result_file(const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (!fp) return -1;
+    char line[TTT_LINE];
+    int value = -1, first = 1;
+    while (value < 0 && fgets(line, sizeof(line), fp)) {
+        char *end;
+        long v = strtol(line, &end, 10);
+        if (first && end != line && (*end == '\n' || *end == '\0' || *end == ' ')) value = (int)v;
+        else value = parse_makespan(line);
+        first = 0;
+    }
+    fclose(fp);
+    return value;
+}
+
+void add_point(Run *run, double time, int makespan) {
+    if (makespan >= run->final || num_points == TTT_MAX_POINTS) return;
+    if (run->num_points == 0) run->first_point = num_points;
+    points[num_points].time = time;
+    points[num_points++].makespan = makespan;
+    run->num_points++;
+    run->final = makespan;
+}
+
+// Splits the command template into argv, substituting the placeholders into buf.
+int build_argv(const Solver *s, const char *instance, const char *output, unsigned long long seed,
+               char *buf, size_t size, char *argv[]) {
+    char seed_text[32], timeout_text[32];
+    snprintf(seed_text, sizeof(seed_text), "%llu", seed);
+    snprintf(timeout_text, sizeof(timeout_text), "%g", timeout_sec);
+    const struct { const char *key, *value; } subs[] = {
+        { "{instance}", instance }, { "{output}", output }, { "{seed}", seed_text }, { "{timeout}", timeout_text } };
+
+    size_t n = 0;
+    for (const char *p = s->command; *p && n + 1 < size; ) {
+        int k;
+        for (k = 0; k < 4; k++) {
+            size_t len = strlen(subs[k].key);
+            if (strncmp(p, subs[k].key, len) == 0) {
+                n += (size_t)snprintf(buf + n, size - n, "%s", subs[k].value);
+                p += len;
+                break;
+            }
+        }
+        if (k == 4) buf[n++] = *p++;
+    }
+    if (n >= size) return -1;
+    buf[n] = '\0';
+
+    int argc = 0;
+    for (char *save, *tok = strtok_r(buf, " ", &save); tok; tok = strtok_r(NULL, " ", &save)) {
+        if (argc == TTT_MAX_ARGS) return -1;
+        argv[argc++] = tok;
+    }
+    argv[argc] = NULL;
+    return argc;
+}
+
+static void take_progress_line(const char *line, double elapsed, void *arg) {
+    int value = parse_makespan(line);
+    if (value > 0) add_point(arg, elapsed, value);
+}
+
+static int past_timeout(double elapsed, void *arg) {
+    (void)arg;
+    return elapsed >= timeout_sec;
+}
+
+/*
+    One run in a fresh work directory (the output file, and V6's
+    interrupted_output.txt, land there). Incumbents are timestamped when
+    their line arrives; the final result is read from the files at exit.
+*/
+void run_solver(int i, int s, int r) {
+    Run *run = &runs[i][s][r];
+    run->num_points = 0;
+    run->final = INT_MAX;
+    run->status = RUN_ERROR;
+    run->wall = 0.0;
+
+    char dir[64], output[PATH_MAX], path[PATH_MAX + 32];
+    static char args[TTT_COMMAND_LEN + 2 * PATH_MAX];
+    char *argv[TTT_MAX_ARGS + 1];
+    if (child_make_dir(dir, sizeof(dir), "ttt_run") != 0) return;
+    snprintf(output, sizeof(output), "%s/output.txt", dir);
+    ChildHooks hooks = { take_progress_line, past_timeout, run, TTT_GRACE_SEC };
+    ChildResult child;
+    if (build_argv(&solvers[s], instances[i], output, base_seed + r, args, sizeof(args), argv) <= 0 ||
+        child_run(dir, argv, &hooks, &child) != 0) {
+        child_remove_dir(dir);
+        return;
+    }
+    run->wall = child.wall;
+
+    int value = read_result_file(output);
+    if (child.interrupted) run->status = RUN_TIMEOUT;
+    else if (WIFEXITED(child.status) && WEXITSTATUS(child.status) == 0 && value > 0) run->status = RUN_DONE;
+    snprintf(path, sizeof(path), "%s/interrupted_output.txt", dir);
+    if (value <= 0) value = read_result_file(path);
+    if (value > 0) add_point(run, run->wall, value);   // solvers without progress lines
+    child_remove_dir(dir);
+}
+
+// ================== Analysis ==================
+int target_makespan(int i, int t) {
+    if (reference[i] == INT_MAX) return -1;   // no run found a schedule
+    return (int)floor(reference[i] * (1.0 + targets[t] / 100.0) + 1e-9);
+}
+
+// Time the run first reached target; -1 if it never did.
+double time_to_target(const Run *run, int target) {
+    for (int k = 0; k < run->num_points; k++)
+        if (points[run->first_point + k].makespan <= target) return points[run->first_point + k].time;
+    return -1.0;
+}
+
+static int by_value(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Sorted times of the runs that reached the target; returns how many.
+int success_times(int i, int s, int t, double *times) {
+    int n = 0;
+    for (int r = 0; r < num_runs; r++) {
+        double ttt = time_to_target(&runs[i][s][r], target_makespan(i, t));
+        if (ttt >= 0.0) times[n++] = ttt;
+    }
+    qsort(times, n, sizeof(double), by_value);
+    return n;
+}
+
+// Expected runtime to reach the target: all time spent / successes (INFINITY without one).
+double expected_runtime(int i, int s, int t) {
+    double total = 0.0;
+    int successes = 0;
+    for (int r = 0; r < num_runs; r++) {
+        double ttt = time_to_target(&runs[i][s][r], target_makespan(i, t));
+        if (ttt >= 0.0) { total += ttt; successes++; }
+        else total += runs[i][s][r].wall;
+    }
+    return successes ? total / successes : INFINITY;
+}
+
+void set_references(void) {
+    for (int i = 0; i < num_instances; i++) {
+        if (reference_given[i]) continue;
+        reference[i] = INT_MAX;
+        for (int s = 0; s < num_solvers; s++)
+            for (int r = 0; r < num_runs; r++)
+                if (runs[i][s][r].final < reference[i]) reference[i] = runs[i][s][r].final;
+    }
+}
+
+void write_runs(const char *prefix) {
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s_runs.csv", prefix);
+    FILE *fp = fopen(path, "w");
+    if (!fp) { perror(path); return; }
+    fprintf(fp, "instance,solver,run,seed,status,final_makespan,wall_time");
+    for (int t = 0; t < num_targets; t++) fprintf(fp, ",ttt_%g", targets[t]);
+    fprintf(fp, "\n");
+    for (int i = 0; i < num_instances; i++)
+        for (int s = 0; s < num_solvers; s++)
+            for (int r = 0; r < num_runs; r++) {
+                const Run *run = &runs[i][s][r];
+                fprintf(fp, "%s,%s,%d,%llu,%s,%d,%.4f", instance_names[i], solvers[s].name, r, base_seed + r,
+                        status_names[run->status], run->final == INT_MAX ? -1 : run->final, run->wall);
+                for (int t = 0; t < num_targets; t++) {
+                    double ttt = time_to_target(run, target_makespan(i, t));
+                    if (ttt >= 0.0) fprintf(fp, ",%.4f", ttt);
+                    else fprintf(fp, ",");
+                }
+                fprintf(fp, "\n");
+            }
+    fclose(fp);
+}
+
+void write_distributions(const char *prefix) {
+    static double times[TTT_MAX_RUNS];
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s_ttt.csv", prefix);
+    FILE *fp = fopen(path, "w");
+    if (!fp) { perror(path); return; }
+    fprintf(fp, "instance,solver,target_pct,target,i,time,probability\n");
+    for (int i = 0; i < num_instances; i++)
+        for (int s = 0; s < num_solvers; s++)
+            for (int t = 0; t < num_targets; t++) {
+                int n = success_times(i, s, t, times);
+                for (int k = 0; k < n; k++)
+                    fprintf(fp, "%s,%s,%g,%d,%d,%.4f,%.4f\n", instance_names[i], solvers[s].name, targets[t],
+                            target_makespan(i, t), k + 1, times[k], (k + 0.5) / num_runs);
+            }
+    fclose(fp);
+}
+
+/*
+    Dolan-More performance profile per target: ratio = ERT / best ERT of
+    the instance; rho(tau) = fraction of instances with ratio <= tau, one
+    row per distinct ratio of the solver (a step function).
+*/
+void write_profiles(const char *prefix) {
+    static double ratios[TTT_MAX_INSTANCES], ert[TTT_MAX_SOLVERS];
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s_profile.csv", prefix);
+    FILE *fp = fopen(path, "w");
+    if (!fp) { perror(path); return; }
+    fprintf(fp, "target_pct,solver,tau,fraction\n");
+    for (int t = 0; t < num_targets; t++) {
+        for (int s = 0; s < num_solvers; s++) {
+            int n = 0;
+            for (int i = 0; i < num_instances; i++) {
+                double best = INFINITY;
+                for (int o = 0; o < num_solvers; o++) {
+                    ert[o] = expected_runtime(i, o, t);
+                    if (ert[o] < best) best = ert[o];
+                }
+                if (isfinite(ert[s])) ratios[n++] = best > 0.0 ? ert[s] / best : 1.0;
+            }
+            qsort(ratios, n, sizeof(double), by_value);
+            for (int k = 0; k < n; k++)
+                if (k + 1 == n || ratios[k + 1] > ratios[k])
+                    fprintf(fp, "%g,%s,%.4f,%.4f\n", targets[t], solvers[s].name, ratios[k], (double)(k + 1) / num_instances);
+        }
+    }
+    fclose(fp);
+}
+
+void print_summary(void) {
+    static double times[TTT_MAX_RUNS];
+    printf("\n%-10s %-8s %8s %7s %8s %10s %10s\n", "instance", "solver", "target", "pct", "success", "median", "ERT");
+    for (int i = 0; i < num_instances; i++) {
+        printf("%s: reference %d (%s)\n", instance_names[i], reference[i], reference_given[i] ? "given" : "best found");
+        for (int t = 0; t < num_targets; t++)
+            for (int s = 0; s < num_solvers; s++) {
+                int n = success_times(i, s, t, times);
+                char median[16] = "-", ert_text[16] = "-";
+                if (2 * n > num_runs) snprintf(median, sizeof(median), "%.3f", times[(num_runs - 1) / 2]);   // misses sort last
+                double ert = expected_runtime(i, s, t);
+                if (isfinite(ert)) snprintf(ert_text, sizeof(ert_text), "%.3f", ert);
+                printf("%-10s %-8s %8d %6g%% %4d/%-3d %10s %10s\n", instance_names[i], solvers[s].name,
+                       target_makespan(i, t), targets[t], n, num_runs, median, ert_text);
+            }
+    }
+}
+
+// ================== Setup ==================
+int add_instance(const char *path) {
+    if (num_instances == TTT_MAX_INSTANCES) { fprintf(stderr, "Too many instances\n"); return -1; }
+    if (!realpath(path, instances[num_instances])) { perror(path); return -1; }
+    const char *base = strrchr(path, '/');
+    snprintf(instance_names[num_instances], sizeof(instance_names[0]), "%s", base ? base + 1 : path);
+    char *dot = strstr(instance_names[num_instances], ".jss");
+    if (dot) *dot = '\0';
+    num_instances++;
+    return 0;
+}
+
+static int by_name(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+// A directory adds its .jss files in name order.
+int add_instances(const char *path) {
+    DIR *d = opendir(path);
+    if (!d) return add_instance(path);
+    static char names[TTT_MAX_INSTANCES][256];
+    char *sorted[TTT_MAX_INSTANCES];
+    int n = 0;
+    for (struct dirent *e; (e = readdir(d)) && n < TTT_MAX_INSTANCES; ) {
+        size_t len = strlen(e->d_name);
+        if (len > 4 && strcmp(e->d_name + len - 4, ".jss") == 0) {
+            snprintf(names[n], sizeof(names[n]), "%s", e->d_name);
+            sorted[n] = names[n];
+            n++;
+        }
+    }
+    closedir(d);
+    qsort(sorted, n, sizeof(char *), by_name);
+    for (int k = 0; k < n; k++) {
+        char file[PATH_MAX];
+        snprintf(file, sizeof(file), "%s/%s", path, sorted[k]);
+        if (add_instance(file) != 0) return -1;
+    }
+    return 0;
+}
+
+int read_references(const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (!fp) { perror(path); return -1; }
+    char line[TTT_LINE], name[64];
+    int value;
+    while (fgets(line, sizeof(line), fp)) {
+        if (line[0] == '#' || sscanf(line, "%63s %d", name, &value) != 2) continue;
+        for (int i = 0; i < num_instances; i++)
+            if (strcmp(instance_names[i], name) == 0) { reference[i] = value; reference_given[i] = 1; }
+    }
+    fclose(fp);
+    return 0;
+}
+
+int parse_targets(const char *list) {
+    num_targets = 0;
+    for (const char *p = list; *p; ) {
+        char *end;
+        double v = strtod(p, &end);
+        if (end == p || v < 0.0 || num_targets == TTT_MAX_TARGETS) return -1;
+        targets[num_targets++] = v;
+        p = *end == ',' ? end + 1 : end;
+        if (*end && *end != ',') return -1;
+    }
+    return num_targets > 0 ? 0 : -1;
+}
+
+// ================== Main ==================
+int main(int argc, char *argv[]) {
+    const char *prefix = "ttt", *reference_file = NULL;
+    for (int a = 1; a < argc; a++) {
+        if (strncmp(argv[a], "--runs=", 7) == 0) num_runs = atoi(argv[a] + 7);
+        else if (strncmp(argv[a], "--timeout=", 10) == 0) timeout_sec = atof(argv[a] + 10);
+        else if (strncmp(argv[a], "--seed=", 7) == 0) base_seed = strtoull(argv[a] + 7, NULL, 10);
+        else if (strncmp(argv[a], "--out=", 6) == 0) prefix = argv[a] + 6;
+        else if (strncmp(argv[a], "--reference=", 12) == 0) reference_file = argv[a] + 12;
+        else if (strncmp(argv[a], "--targets=", 10) == 0) {
+            if (parse_targets(argv[a] + 10) != 0) {
+                fprintf(stderr, "Invalid targets: %s (percentages, at most %d)\n", argv[a] + 10, TTT_MAX_TARGETS);
+                return EXIT_FAILURE;
+            }
+        }
+        else if (strncmp(argv[a], "--solver=", 9) == 0) {
+            const char *spec = argv[a] + 9, *eq = strchr(spec, '=');
+            if (!eq || eq == spec || eq - spec >= (int)sizeof(solvers[0].name) || num_solvers == TTT_MAX_SOLVERS ||
+                strlen(eq + 1) >= TTT_COMMAND_LEN) {
+                fprintf(stderr, "Invalid solver: %s (NAME=COMMAND, at most %d)\n", spec, TTT_MAX_SOLVERS);
+                return EXIT_FAILURE;
+            }
+            snprintf(solvers[num_solvers].name, sizeof(solvers[0].name), "%.*s", (int)(eq - spec), spec);
+            snprintf(solvers[num_solvers].command, TTT_COMMAND_LEN, "%s", eq + 1);
+            num_solvers++;
+        }
+        else if (strncmp(argv[a], "--", 2) == 0) { fprintf(stderr, "Unknown option: %s\n", argv[a]); return EXIT_FAILURE; }
+        else if (add_instances(argv[a]) != 0) return EXIT_FAILURE;
+    }
+    if (num_solvers == 0 || num_instances == 0 || num_runs < 1 || num_runs > TTT_MAX_RUNS || timeout_sec <= 0.0) {
+        fprintf(stderr, "Usage: %s [--runs=N] [--timeout=SEC] [--targets=P,P,..] [--seed=S] [--reference=FILE] [--out=PREFIX]\n"
+                        "       --solver=NAME=COMMAND ... instance.jss|directory ...\n"
+                        "       (runs 1..%d; COMMAND placeholders {instance} {output} {seed} {timeout})\n",
+                argv[0], TTT_MAX_RUNS);
+        return EXIT_FAILURE;
+    }
+    if (reference_file && read_references(reference_file) != 0) return EXIT_FAILURE;
+    signal(SIGPIPE, SIG_IGN);
+
+    for (int i = 0; i < num_instances; i++) {
+        for (int s = 0; s < num_solvers; s++) {
+            int best = INT_MAX;
+            double wall = 0.0;
+            for (int r = 0; r < num_runs; r++) {
+                run_solver(i, s, r);
+                if (runs[i][s][r].final < best) best = runs[i][s][r].final;
+                wall += runs[i][s][r].wall;
+            }
+            printf("[%s] %-8s %d runs | best %d | mean wall %.3fs\n", instance_names[i], solvers[s].name,
+                   num_runs, best == INT_MAX ? -1 : best, wall / num_runs);
+            fflush(stdout);
+        }
+    }
+
+    set_references();
+    write_runs(prefix);
+    write_distributions(prefix);
+    write_profiles(prefix);
+    print_summary();
+    printf("\nWrote %s_runs.csv, %s_ttt.csv and %s_profile.csv\n", prefix, prefix, prefix);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,74 @@
+/*
+    Decoder for the binary branch traces (.trc) written by branch_trace.c.
+    Renders the records in the same text layout the old branches.txt had.
+
+    📄 Compilar:
+    gcc -Wall -O2 -o trace_decode mainTraceDecode.c schedule_output.c
+
+    🚀 Executar:
+    ./trace_decode branches.trc                 (texto para stdout)
+    ./trace_decode branches.trc branches.txt --thread=0 --max-depth=5
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "branch_trace.h"
+#include "schedule_output.h"
+
+#define DECODE_BATCH 4096
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Uso: %s branches.trc [saida.txt] [--thread=N] [--max-depth=N]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char *out_name = NULL;
+    int only_thread = -1;
+    int max_depth = 0;
+    for (int a = 2; a < argc; a++) {
+        if (strncmp(argv[a], "--thread=", 9) == 0) only_thread = atoi(argv[a] + 9);
+        else if (strncmp(argv[a], "--max-depth=", 12) == 0) max_depth = atoi(argv[a] + 12);
+        else if (argv[a][0] != '-' && !out_name) out_name = argv[a];
+        else { fprintf(stderr, "Opção desconhecida: %s\n", argv[a]); return EXIT_FAILURE; }
+    }
+
+    FILE *in = fopen(argv[1], "rb");
+    if (!in) { perror("Erro ao abrir trace"); return EXIT_FAILURE; }
+    char magic[4];
+    uint32_t record_size = 0;
+    if (fread(magic, 1, 4, in) != 4 || memcmp(magic, "JBT1", 4) != 0 ||
+        fread(&record_size, sizeof(record_size), 1, in) != 1 || record_size != sizeof(TraceRecord)) {
+        fprintf(stderr, "Formato de trace inválido\n");
+        fclose(in);
+        return EXIT_FAILURE;
+    }
+
+    FILE *out = out_name ? fopen(out_name, "w") : stdout;
+    if (!out) { perror("Erro output"); fclose(in); return EXIT_FAILURE; }
+
+    static OutputWriter w;
+    static TraceRecord batch[DECODE_BATCH];
+    writer_init(&w, out);
+
+    unsigned long long total = 0;
+    size_t n;
+    while ((n = fread(batch, sizeof(TraceRecord), DECODE_BATCH, in)) > 0) {
+        for (size_t k = 0; k < n; k++) {
+            const TraceRecord *r = &batch[k];
+            if (only_thread >= 0 && (int)r->thread != only_thread) continue;
+            if (max_depth > 0 && r->depth > max_depth) continue;
+            writer_printf(&w,
+                          "[Branch %llu | Profundidade %d] Job %d - Op %d | Máquina: %d | Início: %d | Fim: %d | Makespan parcial: %d\n",
+                          (unsigned long long)r->node, r->depth, r->job, r->op, r->machine,
+                          r->start, r->end, r->partial_makespan);
+            total++;
+        }
+    }
+    writer_flush(&w);
+    fclose(in);
+    if (out != stdout) fclose(out);
+    fprintf(stderr, "%llu registos descodificados\n", total);
+    return EXIT_SUCCESS;
+}
@@ -14,6 +14,7 @@
 #include <string.h>
 #include <omp.h>
 #include <limits.h>
+#include "cache_layout.h"
 
 #define MAX_JOBS     10
 #define MAX_OPS      10
@@ -30,7 +31,7 @@ typedef struct {
 int num_jobs, num_machines, num_ops;
 Operation ops_backup[MAX_JOBS][MAX_OPS];
 int best_makespan = INT_MAX;
-int current_best_live = INT_MAX; // Tracks best found during execution
+CACHE_ALIGNED int current_best_live = INT_MAX; // Tracks best found during execution (own cache line)
 Operation best_schedule[MAX_JOBS][MAX_OPS];
 #pragma omp threadprivate(best_makespan, best_schedule)
 
@@ -103,7 +104,7 @@ void branch_and_bound(int scheduled_ops, int current_makespan,
         temp_job_ready[j] = end;
         temp_job_progress[j]++;
 
-        static int step_count = 0;
+        static CACHE_ALIGNED int step_count = 0;   // own cache line: written at every node
         #pragma omp atomic
         step_count++;
         if (step_count % 1000 == 0) {
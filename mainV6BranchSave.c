@@ -2,55 +2,203 @@
     Job-Shop Scheduler in C using Parallel Branch and Bound with Backtracking
     This version guarantees optimality for small problem instances.
         
-    gcc -fopenmp -Wall -g -o main.exe mainV6BranchSave.c
+    gcc -fopenmp -Wall -g -o main.exe mainV6BranchSave.c par_runtime.c worker_pool.c numa_topology.c schedule_output.c schedule_check.c propagation.c arena.c shape_kernels.c event_stream.c -pthread
+    gcc -Wall -g -o main.exe mainV6BranchSave.c par_runtime.c worker_pool.c numa_topology.c schedule_output.c schedule_check.c propagation.c arena.c shape_kernels.c event_stream.c -pthread   (no libomp)
 
-    clang -Xpreprocessor -fopenmp -I$(brew --prefix libomp)/include -L$(brew --prefix libomp)/lib -lomp mainV6BranchSave.c
+    mpicc -DJSS_MPI -fopenmp -Wall -O2 -o main_mpi mainV6BranchSave.c par_runtime.c worker_pool.c numa_topology.c schedule_output.c schedule_check.c propagation.c arena.c shape_kernels.c event_stream.c node_codec.c mpi_search.c -pthread
+    mpirun -np 8 ./main_mpi Matrizes/ft10.jss teste2.txt 1 1 --order=est   (add --oversubscribe with fewer cores)
+
+    clang -Xpreprocessor -fopenmp -I$(brew --prefix libomp)/include -L$(brew --prefix libomp)/lib -lomp mainV6BranchSave.c par_runtime.c worker_pool.c numa_topology.c schedule_output.c schedule_check.c propagation.c arena.c shape_kernels.c event_stream.c
 
     .\main.exe ft06.jss teste2.txt 4 1 > log.txt
+    .\main.exe ft06.jss teste2.txt 4 1 --gantt=5 --binary=ft06.jsb
+    .\main.exe ft06.jss teste2.txt 4 1 --backend=pool
+    .\main.exe ft06.jss teste2.txt 32 1 --pin
+    .\main.exe la01.jss teste2.txt 4 1 --order=lb --lds=2
+    .\main.exe Matrizes/ft10.jss teste2.txt 8 1 --order=est --bisect=4
+    mkfifo ft10.events; ./main.exe Matrizes/ft10.jss teste2.txt 8 1 --order=est --lds --events=ft10.events & cat ft10.events
+
+    Options:
+    --gantt[=N]      append a Gantt chart, 1 char = N time units (default 5)
+    --binary=FILE    also write the schedule in the compact .jsb format
+    --backend=NAME   omp | pool | seq (par_runtime.h; default omp when built with OpenMP)
+    --pin            pin workers to CPUs, grouped by NUMA node (numa_topology.h)
+    --order=NAME     child order: job (index), est (earliest start), ect (earliest
+                     completion), mwr (most work remaining), lb (lower bound after propagation)
+    --lds[=K]        limited discrepancy passes 0..K (default 3) before the complete search
+    --dominance=SET  off (default) | commute (canonical order of independent decisions)
+                     | shift (left-shift: active schedules only) | all. Both rules follow
+                     start order, so they pay off with --order=est/ect and --lds; under
+                     --order=job they discard the dive's early incumbents
+    --bisect[=K]     instead of the complete search, bisect the makespan between the root
+                     lower bound and the heuristic incumbent with K parallel decision
+                     probes per round (default: one per thread); see bisect()
+    --kernel=generic use the generic expansion kernel even when the instance has a
+                     specialized shape (shape_kernels.h)
+    --events=FILE    stream incumbents, lower bounds, throughput and search phases as
+                     JSON lines to FILE or a FIFO (event_stream.h)
+    --events-interval=SEC  seconds between throughput events (default 1)
 
     Constraints:
     - No pointers or dynamic memory
     - Static arrays only (MAX_JOBS, MAX_OPS, etc.)
     - Computes an optimal schedule via recursive branch-and-bound
-    - Includes OpenMP parallelism at the first depth level
+    - Prunes with constraint propagation on every machine (propagation.h)
+    - Parallel over the first depth level (OpenMP, pthread pool or sequential)
+    - MPI builds (-DJSS_MPI): with more than one rank the complete search is
+      spread over the ranks as encoded subproblems (mpi_search.h); every
+      worker rank searches on one thread, so start one rank per core
 */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <omp.h>
 #include <limits.h>
 #include <signal.h>
+#include <pthread.h>
+#include "jobshop.h"
+#include "schedule_output.h"
+#include "schedule_check.h"
+#include "par_runtime.h"
+#include "cache_layout.h"
+#include "propagation.h"
+#include "arena.h"
+#include "shape_kernels.h"
+#include "event_stream.h"
+#ifdef JSS_MPI
+#include "mpi_search.h"
+#include "node_codec.h"
+#endif
 
-#define MAX_JOBS     10
-#define MAX_OPS      10
-#define MAX_MACHINES 10
+#define MAX_JOBS     15   // 15x15 fits the propagation limits (PROP_MAX_OPS)
+#define MAX_OPS      15
+#define MAX_MACHINES 15
 #define MAX_REPEATS  100
 
-typedef struct {
-    int machine;
-    int duration;
-    int start;
-    int end;
-} Operation;
-
+// Shared state, grouped by who writes it so groups never share a cache line
+// (cache_layout.h): read-only instance / incumbent value read at every node
+// / incumbent schedule written under the lock / interrupt flag.
 int num_jobs, num_machines, num_ops;
 Operation ops_backup[MAX_JOBS][MAX_OPS];
-int best_makespan = INT_MAX;
-int current_best_live = INT_MAX; // Tracks best found during execution
+ParIncumbent best_makespan;                    // own cache line
+CACHE_ALIGNED int current_best_live = INT_MAX; // Tracks best found during execution
 Operation best_schedule[MAX_JOBS][MAX_OPS];
+pthread_mutex_t best_schedule_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Read-only instance replicated per NUMA node, each copy on its own pages
+typedef struct {
+    _Alignas(NUMA_PAGE) Operation ops[MAX_JOBS][MAX_OPS];
+    atomic_int state;                 // 0 empty, 1 being written, 2 ready
+} InstanceReplica;
+InstanceReplica replicas[NUMA_MAX_NODES];
+static _Thread_local Operation (*ops_local)[MAX_OPS] = ops_backup;
+
+// Step and prune counters per worker, one page each: first touched by its own worker
+typedef struct {
+    _Alignas(NUMA_PAGE) unsigned long long steps;
+    unsigned long long pruned_bound;       // end >= incumbent
+    unsigned long long pruned_append;      // est above the append start (propagation)
+    unsigned long long pruned_commute;     // non-canonical order of two commuting decisions
+    unsigned long long pruned_left_shift;  // nodes: an operation fits in an earlier idle gap
+} WorkerCounter;
+WorkerCounter step_counts[PAR_MAX_SLOTS];
+
+// Time windows of each worker's current node (propagation.h), one per worker
+PropState prop_states[PAR_MAX_SLOTS];
+// Root state of a seed subtree, from the worker's node pool (arena.h)
+typedef struct {
+    int job_progress[MAX_JOBS];
+    int job_ready[MAX_JOBS];
+    int machine_ready[MAX_MACHINES];
+    Operation schedule[MAX_JOBS][MAX_OPS];
+} SearchNode;
+Arena arenas[PAR_MAX_SLOTS];
+CACHE_ALIGNED ArenaPool node_pools[PAR_MAX_SLOTS];
+int total_work;   // sum of all durations: horizon before the first incumbent
+// Child ordering (--order) and limited discrepancy search (--lds)
+typedef enum { ORDER_JOB, ORDER_EST, ORDER_ECT, ORDER_MWR, ORDER_LB } ChildOrder;
+const char *order_names[] = { "job", "est", "ect", "mwr", "lb" };
+ChildOrder child_order = ORDER_JOB;
+int lds_passes = -1;                  // -1: plain depth-first search
+#define NO_DISCREPANCY_LIMIT INT_MAX
+int remaining_work[MAX_JOBS][MAX_OPS + 1];   // durations from op i to the end of job j
+int seed_order[MAX_JOBS], num_seeds;
+
+// Decision probes (--bisect): is there a schedule with makespan <= bound?
+typedef enum { PROBE_OPEN, PROBE_FEASIBLE, PROBE_INFEASIBLE, PROBE_CANCELLED } ProbeAnswer;
+typedef struct {
+    ParIncumbent incumbent;   // bound + 1 until a schedule is found (own cache line)
+    int bound;
+    atomic_int pending;       // seed subtrees of the complete pass not finished yet
+    atomic_int answer;        // ProbeAnswer
+} DecisionProbe;
+#define MAX_PROBES PAR_MAX_SLOTS
+#define PROBE_LDS_PASSES 2            // discrepancy passes of every probe before its complete pass
+DecisionProbe probes[MAX_PROBES];
+int num_probes;
+int bisect_probes = 0;                // 0: complete search; -1: one probe per thread
+int bisect_rounds, probe_counts[PROBE_CANCELLED + 1];
+atomic_int lower_bound_live;          // root bound, raised as soon as a probe is proven infeasible
+// The worker's current probe (NULL outside --bisect) and the bound it prunes with
+static _Thread_local DecisionProbe *probe_local = NULL;
+static _Thread_local ParIncumbent *incumbent_local = &best_makespan;
+
+// Dominance rules (--dominance): canonical order of commuting decisions, left shift
+enum { DOMINANCE_COMMUTE = 1, DOMINANCE_SHIFT = 2 };
+int dominance = 0;
+int machine_op[MAX_JOBS][MAX_MACHINES];   // operation of job j on machine m, -1 if none
+int repeated_machines = 0;                // a job visits a machine twice: no left-shift rule
+PropState root_prop;                  // orders the seed jobs
+ShapeKernels kernels;                 // node expansion for the instance shape (shape_kernels.h)
+// Distributed search (JSS_MPI builds, mpi_search.h): ranks besides the master
+int distributed = 0;
+#ifdef JSS_MPI
+// Work units are encoded nodes (node_codec.h). A worker keeps the child list
+// of every frame of its current unit so a SPLIT can give the untried
+// children of the shallowest frame away (mpi_split). Every thread records
+// its frames in its own slot's stack (the master's LDS passes run in
+// parallel); units are searched, and split, by the rank's calling thread.
+typedef struct {
+    int *order;                       // the frame's children, NULL once it returned
+    int n, c;                         // children the frame will try / the one being searched
+} SplitFrame;
+#define MPI_POLL_INTERVAL    1024     // nodes between two mpi_poll()
+#define MPI_UNITS_PER_WORKER 4        // initial frontier built by the master
+#define MPI_FRONTIER_UNITS   2048
+#define SPLIT_MIN_REMAINING  8        // donate only subtrees with at least this many operations left
+NodeCodec codec;
+SplitFrame split_stacks[PAR_MAX_SLOTS][MAX_JOBS * MAX_OPS + 1];
+int unit_path[MAX_JOBS * MAX_OPS], unit_depth = -1;   // -1: no unit being searched
+int frontier_units, frontier_depth;
+MpiRankStats rank_stats[MPI_MAX_RANKS];
+#endif
 double program_start_time;
-volatile sig_atomic_t interrupted = 0;
-#pragma omp threadprivate(best_makespan, best_schedule)
+CACHE_ALIGNED volatile sig_atomic_t interrupted = 0;
+// Shared incumbent: threadprivate copies left the master's best_schedule stale
+// whenever another thread found the optimum (caught by assert_valid_schedule).
 
+/*
+    SIGINT only raises the flag (all the handler may safely do): the search
+    returns at its next node, and main() reports the best schedule so far
+    with write_interrupted_output(). A second SIGINT ends the process at once.
+*/
 void handle_interrupt(int signum) {
+    (void)signum;
     interrupted = 1;
-    double elapsed = omp_get_wtime() - program_start_time;
+    signal(SIGINT, SIG_DFL);
+}
+
+// Runs on the main thread after the search has stopped.
+void write_interrupted_output(void) {
+    double elapsed = par_time() - program_start_time;
     fprintf(stderr, "\n[INTERRUPTED] Best makespan so far: %d | Total time: %.2f sec\n", current_best_live, elapsed);
+    int lower_bound = atomic_load(&lower_bound_live);
+    fprintf(stderr, "[INTERRUPTED] Lower bound: %d\n", lower_bound);
     FILE *fp = fopen("interrupted_output.txt", "w");
     if (fp) {
         fprintf(fp, "# INTERRUPTED EXECUTION\n");
         fprintf(fp, "Best makespan: %d\n", current_best_live);
+        fprintf(fp, "Lower bound: %d\n", lower_bound);
         fprintf(fp, "Total time: %.2f sec\n", elapsed);
         for (int j = 0; j < num_jobs; j++) {
             for (int i = 0; i < num_ops; i++) {
@@ -60,7 +208,6 @@ void handle_interrupt(int signum) {
         }
         fclose(fp);
     }
-    exit(EXIT_FAILURE);
 }
 
 void read_input(const char *filename) {
@@ -69,13 +216,31 @@ void read_input(const char *filename) {
     if (fscanf(fp, "%d %d", &num_jobs, &num_machines) != 2) {
         fprintf(stderr, "Invalid input format\n"); fclose(fp); exit(EXIT_FAILURE);
     }
+    if (num_jobs < 1 || num_jobs > MAX_JOBS || num_machines < 1 || num_machines > MAX_MACHINES) {
+        fprintf(stderr, "Instance too large (at most %d jobs x %d machines)\n", MAX_JOBS, MAX_MACHINES);
+        fclose(fp); exit(EXIT_FAILURE);
+    }
     num_ops = num_machines;
+    total_work = 0;
     for (int j = 0; j < num_jobs; j++) {
         for (int i = 0; i < num_ops; i++) {
             if (fscanf(fp, "%d %d", &ops_backup[j][i].machine, &ops_backup[j][i].duration) != 2) {
                 fprintf(stderr, "Invalid operation data\n"); fclose(fp); exit(EXIT_FAILURE);
             }
+            total_work += ops_backup[j][i].duration;
         }
+        for (int m = 0; m < num_machines; m++) machine_op[j][m] = -1;
+        for (int i = 0; i < num_ops; i++) {
+            int m = ops_backup[j][i].machine;
+            if (m < 0 || m >= num_machines) {
+                fprintf(stderr, "Invalid machine %d (job %d op %d)\n", m, j, i); fclose(fp); exit(EXIT_FAILURE);
+            }
+            if (machine_op[j][m] >= 0) repeated_machines = 1;
+            else machine_op[j][m] = i;
+        }
+        remaining_work[j][num_ops] = 0;
+        for (int i = num_ops - 1; i >= 0; i--)
+            remaining_work[j][i] = remaining_work[j][i + 1] + ops_backup[j][i].duration;
     }
     fclose(fp);
 }
@@ -86,171 +251,862 @@ void copy_schedule(Operation dest[MAX_JOBS][MAX_OPS], Operation src[MAX_JOBS][MA
             dest[j][i] = src[j][i];
 }
 
-void branch_and_bound(int scheduled_ops, int current_makespan,
+/*
+    Left-shift dominance: an operation with release time ready and duration
+    d that fits in an idle gap before machine_ready[m] will still fit there
+    whenever it is appended (its job predecessor is scheduled and gaps never
+    close), so every completion of the node is non-active. Active schedules
+    contain an optimum and are all reached without such gaps, so the whole
+    node is pruned. The scheduled operations of m are collected through
+    machine_op and swept in start order.
+*/
+int fits_in_gap(Operation current_schedule[MAX_JOBS][MAX_OPS], int job_progress[MAX_JOBS], int m, int ready, int d) {
+    int starts[MAX_JOBS], ends[MAX_JOBS], n = 0;
+    for (int j = 0; j < num_jobs; j++) {
+        int i = machine_op[j][m];
+        if (i < 0 || i >= job_progress[j]) continue;
+        int c = n++;
+        while (c > 0 && starts[c - 1] > current_schedule[j][i].start) {
+            starts[c] = starts[c - 1]; ends[c] = ends[c - 1]; c--;
+        }
+        starts[c] = current_schedule[j][i].start;
+        ends[c] = current_schedule[j][i].end;
+    }
+    int free_from = 0;
+    for (int c = 0; c < n; c++) {
+        int t = free_from > ready ? free_from : ready;
+        if (t + d <= starts[c]) return 1;
+        free_from = ends[c];
+    }
+    return 0;
+}
+
+/*
+    Candidate children of a node in the --order heuristic order (ties by
+    job index); 0 when the node is dominated (left shift). Children that
+    cannot improve, cannot be appended now or repeat a commuting pair are
+    left out, each rule with its own counter; ORDER_LB
+    propagates every child to rank it by its lower bound and also leaves out
+    the ones that fail.
+
+    Commuting decisions: when the previous decision (last_job) and this
+    child are on different jobs and machines, neither changes the other's
+    start, so both orders reach the same node. Only the order by (start,
+    job) is explored: every schedule keeps the sequence sorted that way, and
+    est/ect dives rarely break it, so the first incumbent comes as early as
+    without the rule.
+*/
+int order_children(PropState *prop, int last_job, int job_progress[MAX_JOBS], int job_ready[MAX_JOBS],
+                   int machine_ready[MAX_MACHINES], Operation current_schedule[MAX_JOBS][MAX_OPS],
+                   int best, int order[MAX_JOBS]) {
+    WorkerCounter *counter = &step_counts[par_worker_id()];
+    int last_machine = -1, last_start = 0;
+    if (last_job >= 0) {
+        last_machine = ops_local[last_job][job_progress[last_job] - 1].machine;
+        last_start = current_schedule[last_job][job_progress[last_job] - 1].start;
+    }
+    int rules = best < INT_MAX ? dominance : 0;   // first dive unrestricted: reach an incumbent
+    if ((rules & DOMINANCE_SHIFT) && !repeated_machines) {
+        for (int j = 0; j < num_jobs; j++) {
+            int next_op = job_progress[j];
+            if (next_op >= num_ops) continue;
+            int m = ops_local[j][next_op].machine;
+            if (machine_ready[m] > job_ready[j] &&
+                fits_in_gap(current_schedule, job_progress, m, job_ready[j], ops_local[j][next_op].duration)) {
+                counter->pruned_left_shift++;
+                return 0;
+            }
+        }
+    }
+
+    int key[MAX_JOBS], n = 0;
+    int starts[MAX_JOBS], ends[MAX_JOBS];
+    kernels.expand(&ops_local[0][0], MAX_OPS, num_jobs, num_ops, job_progress, job_ready, machine_ready, starts, ends);
+    for (int j = 0; j < num_jobs; j++) {
+        int next_op = job_progress[j];
+        if (next_op >= num_ops) continue;
+
+        int m = ops_local[j][next_op].machine;
+        int start = starts[j];
+        int end = ends[j];
+        if (end >= best) { counter->pruned_bound++; continue; }
+        if (prop_est(prop, j, next_op) > start) { counter->pruned_append++; continue; }
+        if ((rules & DOMINANCE_COMMUTE) && j != last_job && m != last_machine &&
+            (start < last_start || (start == last_start && j < last_job))) {
+            counter->pruned_commute++;
+            continue;
+        }
+
+        int k;
+        switch (child_order) {
+        case ORDER_EST: k = start; break;
+        case ORDER_ECT: k = end; break;
+        case ORDER_MWR: k = -remaining_work[j][next_op]; break;
+        case ORDER_LB: {
+            int mark = prop_push(prop);
+            k = prop_schedule(prop, j, next_op, start) == 0 ? prop_lower_bound(prop) : INT_MAX;
+            prop_pop(prop, mark);
+            if (k >= best) continue;
+            break;
+        }
+        default: k = j; break;
+        }
+
+        int c = n++;
+        while (c > 0 && key[c - 1] > k) { key[c] = key[c - 1]; order[c] = order[c - 1]; c--; }
+        key[c] = k;
+        order[c] = j;
+    }
+    return n;
+}
+
+/*
+    Answers a probe. An answer also settles the probes it implies: a
+    schedule within bound is within every larger bound, and no schedule
+    within bound means none within a smaller one. Those probes are cancelled
+    and their workers return at the next node.
+*/
+void settle_probe(DecisionProbe *p, ProbeAnswer answer) {
+    int open = PROBE_OPEN;
+    if (!atomic_compare_exchange_strong(&p->answer, &open, answer)) return;
+    int lower_bound = atomic_load(&lower_bound_live);
+    while (answer == PROBE_INFEASIBLE && p->bound + 1 > lower_bound) {
+        if (atomic_compare_exchange_weak(&lower_bound_live, &lower_bound, p->bound + 1)) {
+            events_lower_bound(par_worker_id(), p->bound + 1);
+            break;
+        }
+    }
+    for (int q = 0; q < num_probes; q++) {
+        if (&probes[q] == p) continue;
+        if (answer == PROBE_FEASIBLE ? probes[q].bound < p->bound : probes[q].bound > p->bound) continue;
+        open = PROBE_OPEN;
+        atomic_compare_exchange_strong(&probes[q].answer, &open, PROBE_CANCELLED);
+    }
+}
+
+static inline int probe_settled(void) {
+    return probe_local && atomic_load_explicit(&probe_local->answer, memory_order_relaxed) != PROBE_OPEN;
+}
+
+/*
+    Depth-first search that appends one operation per level, updated in
+    place and undone on return. The worker's PropState keeps the time
+    windows of the node: the incumbent becomes the horizon (makespan <=
+    best - 1), a failed propagation or a lower bound >= best prunes the
+    node, and an operation whose est exceeds its append start cannot be the
+    next one on its machine, so that child is never visited.
+
+    Children are tried in --order; every child but the first spends one
+    discrepancy, and a node with none left only follows the heuristic.
+*/
+void branch_and_bound(int scheduled_ops, int current_makespan, int discrepancies, int last_job,
                       int job_progress[MAX_JOBS],
                       int job_ready[MAX_JOBS],
                       int machine_ready[MAX_MACHINES],
                       Operation current_schedule[MAX_JOBS][MAX_OPS]) {
-    static unsigned long long step_count = 0;
-    if (interrupted) return;
+    if (interrupted || probe_settled()) return;
 
     if (scheduled_ops == num_jobs * num_ops) {
-        if (current_makespan < best_makespan) {
-            #pragma omp critical
-            {
-                if (current_makespan < best_makespan) {
-                    best_makespan = current_makespan;
-                    current_best_live = current_makespan;
-                    copy_schedule(best_schedule, current_schedule);
-                }
+        if (current_makespan < par_incumbent_get(incumbent_local)) {
+            // The lock keeps best_schedule consistent with the incumbent value
+            pthread_mutex_lock(&best_schedule_lock);
+            int improved = par_incumbent_improve(incumbent_local, current_makespan);
+            if (incumbent_local != &best_makespan)
+                improved = par_incumbent_improve(&best_makespan, current_makespan);
+            if (improved) {
+                current_best_live = current_makespan;
+                copy_schedule(best_schedule, current_schedule);
+                events_incumbent(par_worker_id(), current_makespan);
+            }
+            pthread_mutex_unlock(&best_schedule_lock);
+            if (improved) {   // stdout may block: never while other workers wait for the lock
+                printf("[Incumbent] %d | Elapsed=%.2fs\n", current_makespan, par_time() - program_start_time);
+                fflush(stdout);
             }
+#ifdef JSS_MPI
+            if (improved) mpi_publish_incumbent(current_makespan);
+#endif
+            if (probe_local) settle_probe(probe_local, PROBE_FEASIBLE);
         }
         return;
     }
 
-    for (int j = 0; j < num_jobs; j++) {
-        int next_op = job_progress[j];
-        if (next_op >= num_ops) continue;
+    PropState *prop = &prop_states[par_worker_id()];
+    int best = par_incumbent_get(incumbent_local);
+    if (prop_set_horizon(prop, best - 1) < 0 || prop_lower_bound(prop) >= best) return;
 
-        int m = ops_backup[j][next_op].machine;
-        int d = ops_backup[j][next_op].duration;
+    int order[MAX_JOBS];
+    int n = order_children(prop, last_job, job_progress, job_ready, machine_ready, current_schedule, best, order);
+#ifdef JSS_MPI
+    SplitFrame *frame = &split_stacks[par_worker_id()][scheduled_ops];   // mpi_split() may lower frame->n
+    frame->order = order;
+    frame->n = n;
+#endif
+    for (int c = 0; c < n; c++) {
+        if (c > 0 && discrepancies == 0) break;
+#ifdef JSS_MPI
+        if (c >= frame->n) break;
+        frame->c = c;
+#endif
+        int j = order[c];
+        int next_op = job_progress[j];
+        int m = ops_local[j][next_op].machine;
+        int d = ops_local[j][next_op].duration;
         int start = machine_ready[m] > job_ready[j] ? machine_ready[m] : job_ready[j];
         int end = start + d;
 
-        if (end >= best_makespan) continue; // prune
-
-        Operation temp_schedule[MAX_JOBS][MAX_OPS];
-        int temp_job_ready[MAX_JOBS];
-        int temp_machine_ready[MAX_MACHINES];
-        int temp_job_progress[MAX_JOBS];
-
-        copy_schedule(temp_schedule, current_schedule);
-        memcpy(temp_job_ready, job_ready, sizeof(temp_job_ready));
-        memcpy(temp_machine_ready, machine_ready, sizeof(temp_machine_ready));
-        memcpy(temp_job_progress, job_progress, sizeof(temp_job_progress));
-
-        temp_schedule[j][next_op].machine = m;
-        temp_schedule[j][next_op].duration = d;
-        temp_schedule[j][next_op].start = start;
-        temp_schedule[j][next_op].end = end;
-        temp_machine_ready[m] = end;
-        temp_job_ready[j] = end;
-        temp_job_progress[j]++;
-
-        #pragma omp atomic
-        step_count++;
-        if (step_count % 100000000 == 0) {
-            double elapsed = omp_get_wtime() - program_start_time;
+        if (end >= par_incumbent_get(incumbent_local)) continue; // prune (the incumbent may have moved)
+
+        unsigned long long steps = ++step_counts[par_worker_id()].steps;
+        if (steps % 100000000 == 0) {
+            double elapsed = par_time() - program_start_time;
             printf("[Thread %d] Iteration %llu | Current=%d | Best=%d | Elapsed=%.2fs\n",
-                   omp_get_thread_num(), step_count, current_makespan, current_best_live, elapsed);
+                   par_worker_id(), steps, current_makespan, current_best_live, elapsed);
             fflush(stdout);
         }
+#ifdef JSS_MPI
+        if (steps % MPI_POLL_INTERVAL == 0) mpi_poll();
+#endif
 
-        branch_and_bound(scheduled_ops + 1,
-                         (end > current_makespan ? end : current_makespan),
-                         temp_job_progress,
-                         temp_job_ready,
-                         temp_machine_ready,
-                         temp_schedule);
-    }
-}
+        int mark = prop_push(prop);
+        if (prop_schedule(prop, j, next_op, start) == 0) {
+            int old_machine_ready = machine_ready[m];
+            int old_job_ready = job_ready[j];
+            current_schedule[j][next_op].machine = m;
+            current_schedule[j][next_op].duration = d;
+            current_schedule[j][next_op].start = start;
+            current_schedule[j][next_op].end = end;
+            machine_ready[m] = end;
+            job_ready[j] = end;
+            job_progress[j]++;
+
+            int left = discrepancies == NO_DISCREPANCY_LIMIT || c == 0 ? discrepancies : discrepancies - 1;
+            branch_and_bound(scheduled_ops + 1,
+                             (end > current_makespan ? end : current_makespan), left, j,
+                             job_progress, job_ready, machine_ready, current_schedule);
 
-void print_gantt_chart(FILE *fp) {
-    const int block_size = 5;
-    int makespan = best_makespan;
-    int blocks = (makespan + block_size - 1) / block_size;
-
-    fprintf(fp, "\n# Gantt Chart (1 char = %d time units)\n", block_size);
-    for (int m = 0; m < num_machines; m++) {
-        fprintf(fp, "Machine %2d |", m);
-        for (int b = 0; b < blocks; b++) {
-            int t_start = b * block_size;
-            int t_end = t_start + block_size;
-            int printed = 0;
-            for (int j = 0; j < num_jobs && !printed; j++)
-                for (int i = 0; i < num_ops; i++)
-                    if (best_schedule[j][i].machine == m && best_schedule[j][i].start < t_end && best_schedule[j][i].end > t_start) {
-                        fprintf(fp, "J%d", j);
-                        printed = 1;
-                        break;
-                    }
-            if (!printed) fprintf(fp, "  ");
+            job_progress[j]--;
+            job_ready[j] = old_job_ready;
+            machine_ready[m] = old_machine_ready;
         }
-        fprintf(fp, "|\n");
-    }
-    fprintf(fp, "\nTime       ");
-    for (int b = 0; b < blocks; b++) {
-        int label = b * block_size;
-        fprintf(fp, label < 10 ? "  %d" : label < 100 ? " %d" : "%d", label);
+        prop_pop(prop, mark);
     }
-    fprintf(fp, " %d\n", makespan);
+#ifdef JSS_MPI
+    frame->order = NULL;
+#endif
 }
 
-void write_output(const char *filename, double avg_time, int repeats, const char *input_name) {
+// Zeroes every worker's node, pruning and propagation counters.
+void reset_counters(void) {
+    memset(step_counts, 0, sizeof(step_counts));
+    for (int slot = 0; slot < PAR_MAX_SLOTS; slot++)
+        prop_states[slot].calls = prop_states[slot].failures = prop_states[slot].est_updates = prop_states[slot].lct_updates = 0;
+}
+
+void write_output(const char *filename, double avg_time, int repeats, const char *input_name,
+                  int gantt_resolution, const char *binary_filename) {
     FILE *fp = fopen(filename, "w");
     if (!fp) { perror("Error opening output file"); exit(EXIT_FAILURE); }
 
-    fprintf(fp, "# Job-Shop Solution for: %s\n", input_name);
-    fprintf(fp, "# Jobs: %d | Machines: %d | Operations per Job: %d\n\n", num_jobs, num_machines, num_ops);
+    static OutputWriter w;
+    static MachineTimeline timeline;
+    ScheduleView view = SCHEDULE_VIEW(best_schedule, num_jobs, num_ops, num_machines);
+    writer_init(&w, fp);
 
-    fprintf(fp, "Best makespan: %d\n", best_makespan);
-    for (int j = 0; j < num_jobs; j++) {
-        for (int i = 0; i < num_ops; i++)
-            fprintf(fp, "%d ", best_schedule[j][i].start);
-        fprintf(fp, "\n");
+    writer_printf(&w, "# Job-Shop Solution for: %s\n", input_name);
+    writer_printf(&w, "# Jobs: %d | Machines: %d | Operations per Job: %d\n\n", num_jobs, num_machines, num_ops);
+
+    writer_printf(&w, "Best makespan: %d\n", par_incumbent_get(&best_makespan));
+    writer_puts(&w, "Optimality: proven\n");   // written only after a completed search
+    write_schedule_text(&w, view);
+    if (gantt_resolution > 0 && build_timeline(&timeline, view) == 0)
+        write_gantt_chart(&w, &timeline, gantt_resolution);
+    writer_puts(&w, "\n# Performance Analysis\n");
+    writer_printf(&w, "Average runtime over %d repetitions: %.6f seconds\n", repeats, avg_time);
+    writer_printf(&w, "Backend: %s | Threads: %d | NUMA nodes: %d\n",
+                  par_backend_name(par_current_backend()), par_threads(), par_num_nodes());
+
+    unsigned long long calls = 0, failures = 0, est_updates = 0, lct_updates = 0;
+    for (int slot = 0; slot < PAR_MAX_SLOTS; slot++) {
+        calls += prop_states[slot].calls;
+        failures += prop_states[slot].failures;
+        est_updates += prop_states[slot].est_updates;
+        lct_updates += prop_states[slot].lct_updates;
     }
-    print_gantt_chart(fp);
-    fprintf(fp, "\n# Performance Analysis\n");
-    fprintf(fp, "Average runtime over %d repetitions: %.6f seconds\n", repeats, avg_time);
+    static const char *dominance_names[] = {"off", "commute", "shift", "all"};
+    writer_printf(&w, "Child order: %s | LDS passes: %d | Dominance: %s | Kernel: %s\n", order_names[child_order],
+                  lds_passes >= 0 ? lds_passes + 1 : 0, dominance_names[dominance], kernels.name);
+    unsigned long long nodes = 0, pruned[4] = {0};
+    for (int slot = 0; slot < PAR_MAX_SLOTS; slot++) {
+        nodes += step_counts[slot].steps;
+        pruned[0] += step_counts[slot].pruned_bound;
+        pruned[1] += step_counts[slot].pruned_append;
+        pruned[2] += step_counts[slot].pruned_commute;
+        pruned[3] += step_counts[slot].pruned_left_shift;
+    }
+    writer_printf(&w, "Nodes: %llu | Pruned children: bound %llu | append %llu | commute %llu | Left-shift nodes: %llu\n",
+                  nodes, pruned[0], pruned[1], pruned[2], pruned[3]);
+    writer_printf(&w, "Propagation: %llu calls | %llu failures | %llu est / %llu lct updates\n",
+                  calls, failures, est_updates, lct_updates);
+    ArenaStats arena = arena_stats(arenas, PAR_MAX_SLOTS);
+    writer_printf(&w, "Arena: peak %zu KB | %llu allocations | %llu nodes (%llu from free lists) | %llu blocks\n",
+                  arena.peak_bytes >> 10, arena.allocs, arena.node_allocs, arena.node_reused, arena.blocks);
+    if (bisect_probes > 0)
+        writer_printf(&w, "Bisection: LB %d | UB %d | %d rounds | probes %d feasible / %d infeasible / %d cancelled\n",
+                      atomic_load(&lower_bound_live), par_incumbent_get(&best_makespan), bisect_rounds,
+                      probe_counts[PROBE_FEASIBLE], probe_counts[PROBE_INFEASIBLE], probe_counts[PROBE_CANCELLED]);
+#ifdef JSS_MPI
+    if (distributed) {
+        unsigned long long units = 0, donated = 0;
+        for (int r = 1; r <= distributed; r++) { units += rank_stats[r].units; donated += rank_stats[r].donated; }
+        writer_printf(&w, "MPI: %d ranks | %d initial units at depth %d | %llu units searched (%llu split off busy workers)\n",
+                      distributed + 1, frontier_units, frontier_depth, units, donated);
+        for (int r = 0; r <= distributed; r++) {
+            const MpiRankStats *st = &rank_stats[r];
+            writer_printf(&w, "Rank %d: nodes %llu | units %llu | search %.3fs | comm %.4fs (%.2f%%) | idle %.3fs"
+                              " | messages %llu sent / %llu received | %.1f / %.1f KB\n",
+                          r, st->nodes, st->units, st->search_time, st->comm_time,
+                          st->wall_time > 0 ? 100.0 * st->comm_time / st->wall_time : 0.0, st->idle_time,
+                          st->sent, st->received, st->bytes_sent / 1024.0, st->bytes_received / 1024.0);
+        }
+    }
+#endif
+    writer_flush(&w);
     fclose(fp);
+
+    if (binary_filename && write_schedule_binary(binary_filename, view, par_incumbent_get(&best_makespan)) != 0)
+        perror("Error writing binary schedule");
+}
+
+
+/*
+    Points ops_local at the instance copy of the worker's node. The first
+    worker of a node to get here writes the copy (so its pages are allocated
+    on that node); the others read ops_backup until it is ready.
+*/
+void select_replica(void) {
+    InstanceReplica *r = &replicas[par_worker_node()];
+    int state = atomic_load_explicit(&r->state, memory_order_acquire);
+    if (state == 0 && atomic_compare_exchange_strong(&r->state, &state, 1)) {
+        memcpy(r->ops, ops_backup, sizeof(ops_backup));
+        atomic_store_explicit(&r->state, 2, memory_order_release);
+        state = 2;
+    }
+    ops_local = state == 2 ? r->ops : ops_backup;
+}
+
+// Branch-and-bound subtree with seed_order[rank] as the first job scheduled.
+void search_seed(PropState *prop, int rank, int budget) {
+    ArenaPool *pool = &node_pools[par_worker_id()];
+    if (!pool->arena) arena_pool_init(pool, &arenas[par_worker_id()], sizeof(SearchNode));
+    SearchNode *node = arena_pool_alloc(pool);
+    if (!node) { fprintf(stderr, "Arena exhausted (ARENA_REGION_BYTES)\n"); exit(EXIT_FAILURE); }
+    memset(node, 0, sizeof(*node));
+    int seed_job = seed_order[rank];
+    int *job_progress = node->job_progress;
+    int *job_ready = node->job_ready;
+    int *machine_ready = node->machine_ready;
+    Operation (*current_schedule)[MAX_OPS] = node->schedule;
+
+    int m = ops_local[seed_job][0].machine;
+    int d = ops_local[seed_job][0].duration;
+    int best = par_incumbent_get(incumbent_local);
+    int mark = prop_push(prop);
+    if (prop_set_horizon(prop, best - 1) == 0 && prop_est(prop, seed_job, 0) == 0 &&
+        prop_schedule(prop, seed_job, 0, 0) == 0) {
+        current_schedule[seed_job][0].machine = m;
+        current_schedule[seed_job][0].duration = d;
+        current_schedule[seed_job][0].start = 0;
+        current_schedule[seed_job][0].end = d;
+        machine_ready[m] = d;
+        job_ready[seed_job] = d;
+        job_progress[seed_job] = 1;
+
+        int left = budget == NO_DISCREPANCY_LIMIT || rank == 0 ? budget : budget - 1;
+        branch_and_bound(1, d, left, seed_job, job_progress, job_ready, machine_ready, current_schedule);
+    }
+    prop_pop(prop, mark);
+    arena_pool_free(pool, node);
+}
+
+/*
+    One branch-and-bound subtree per first job scheduled, the seed jobs taken
+    in --order (seed_order). ctx is the discrepancy budget of the pass.
+*/
+void search_seed_jobs(void *ctx, int begin, int end) {
+    int budget = *(int *)ctx;
+    select_replica();
+    PropState *prop = &prop_states[par_worker_id()];
+    if (prop_init(prop, SCHEDULE_VIEW(ops_local, num_jobs, num_ops, num_machines), total_work) < 0) return;
+    for (int rank = begin; rank < end; rank++) {
+        if (rank > 0 && budget == 0) break;
+        search_seed(prop, rank, budget);
+    }
 }
 
+/*
+    Task t is seed subtree t / num_probes of probe t % num_probes: the
+    probes advance together and the workers spread over them like thread
+    groups, regrouping on the open ones as the others get settled. The
+    worker searches with the probe's own incumbent (bound + 1) and the
+    discrepancy budget of the pass (ctx). In the complete pass, the last
+    subtree of a probe to finish without a schedule proves it infeasible.
+*/
+void search_probes(void *ctx, int begin, int end) {
+    int budget = *(int *)ctx;
+    select_replica();
+    PropState *prop = &prop_states[par_worker_id()];
+    for (int t = begin; t < end; t++) {
+        DecisionProbe *p = &probes[t % num_probes];
+        int rank = t / num_probes;
+        if (rank > 0 && budget == 0) break;
+        if (atomic_load(&p->answer) == PROBE_OPEN &&
+            prop_init(prop, SCHEDULE_VIEW(ops_local, num_jobs, num_ops, num_machines), total_work) == 0) {
+            probe_local = p;
+            incumbent_local = &p->incumbent;
+            search_seed(prop, rank, budget);
+            probe_local = NULL;
+            incumbent_local = &best_makespan;
+        }
+        if (budget == NO_DISCREPANCY_LIMIT && atomic_fetch_sub(&p->pending, 1) == 1)
+            settle_probe(p, PROBE_INFEASIBLE);
+    }
+}
 
-double measure_execution(int threads, int repeats) {
+// Seed jobs of the next pass, ordered like the children of any node.
+void order_seed_jobs(void) {
+    int job_progress[MAX_JOBS] = {0}, job_ready[MAX_JOBS] = {0}, machine_ready[MAX_MACHINES] = {0};
+    static Operation empty_schedule[MAX_JOBS][MAX_OPS];
+    ops_local = ops_backup;
+    num_seeds = 0;
+    if (prop_init(&root_prop, SCHEDULE_VIEW(ops_backup, num_jobs, num_ops, num_machines), total_work) < 0) return;
+    int best = par_incumbent_get(&best_makespan);
+    if (prop_set_horizon(&root_prop, best - 1) < 0) return;
+    num_seeds = order_children(&root_prop, -1, job_progress, job_ready, machine_ready, empty_schedule, best, seed_order);
+}
+
+/*
+    Largest horizon under hi at which propagation fails at the root, plus
+    one. Propagation is monotone in the horizon, so a binary search between
+    the bound of the initial windows and hi finds it.
+*/
+int root_lower_bound(int hi) {
+    ScheduleView view = SCHEDULE_VIEW(ops_backup, num_jobs, num_ops, num_machines);
+    if (prop_init(&root_prop, view, total_work) < 0) return 0;
+    int lo = prop_lower_bound(&root_prop);
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        prop_init(&root_prop, view, total_work);
+        if (prop_set_horizon(&root_prop, mid) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/*
+    Decision-version search: the optimum lies in [lo, hi], hi the best
+    makespan found. Each round spreads up to --bisect probes evenly over
+    [lo, hi - 1] and runs them in parallel (search_probes); a feasible probe
+    lowers hi to the schedule it found, an infeasible one raises lo above
+    its bound. Depth-first search under a tight bound has heavy tails: one
+    bad early decision can hide every schedule for a long time, so the
+    probes first run PROBE_LDS_PASSES discrepancy passes, which answer most
+    feasible probes, and only the open ones go on to the complete pass. Both move monotonically, and [lo, hi] is a proven optimality
+    gap at any time. Every round answers at least one probe, so it ends
+    with lo == hi: hi is optimal.
+*/
+void bisect(double t0, int verbose) {
+    int hi = par_incumbent_get(&best_makespan);
+    int lo = root_lower_bound(hi);
+    atomic_store(&lower_bound_live, lo);
+    events_lower_bound(EVENTS_CONTROL, lo);
+    if (verbose) printf("[Bisect] root | LB=%d | UB=%d | Elapsed=%.2fs\n", lo, hi, par_time() - t0);
+
+    while (lo < hi && !interrupted) {
+        order_seed_jobs();
+        if (num_seeds == 0) { lo = hi; break; }   // nothing below hi survives the root
+
+        int k = bisect_probes < hi - lo ? bisect_probes : hi - lo;
+        events_phase("bisect_round", bisect_rounds + 1);
+        num_probes = 0;
+        for (int i = 0; i < k; i++) {
+            int bound = lo + (int)((long long)(hi - lo) * (i + 1) / (k + 1));
+            if (num_probes > 0 && probes[num_probes - 1].bound == bound) continue;
+            DecisionProbe *p = &probes[num_probes++];
+            p->bound = bound;
+            par_incumbent_init(&p->incumbent, bound + 1);
+            atomic_store(&p->pending, num_seeds);
+            atomic_store(&p->answer, PROBE_OPEN);
+        }
+        for (int pass = 0; ; pass++) {
+            int budget = pass <= PROBE_LDS_PASSES ? pass : NO_DISCREPANCY_LIMIT;
+            par_for(num_probes * num_seeds, 1, search_probes, &budget);
+            int open = 0;
+            for (int q = 0; q < num_probes; q++) open |= atomic_load(&probes[q].answer) == PROBE_OPEN;
+            if (!open || budget == NO_DISCREPANCY_LIMIT || interrupted) break;
+        }
+
+        for (int q = 0; q < num_probes; q++) {
+            int answer = atomic_load(&probes[q].answer);
+            probe_counts[answer]++;
+            if (answer == PROBE_INFEASIBLE && probes[q].bound + 1 > lo) lo = probes[q].bound + 1;
+        }
+        hi = par_incumbent_get(&best_makespan);
+        bisect_rounds++;
+        if (verbose) {
+            printf("[Bisect] round %d | %d probes | LB=%d | UB=%d | Gap=%.2f%% | Elapsed=%.2fs\n",
+                   bisect_rounds, num_probes, lo, hi, 100.0 * (hi - lo) / hi, par_time() - t0);
+            fflush(stdout);
+        }
+    }
+    atomic_store(&lower_bound_live, lo);
+}
+
+#ifdef JSS_MPI
+// ================== Distributed Search (MPI) ==================
+// State and schedule after appending the decisions of path in order.
+void replay_path(const int *path, int depth, int job_progress[MAX_JOBS], int job_ready[MAX_JOBS],
+                 int machine_ready[MAX_MACHINES]) {
+    memset(job_progress, 0, sizeof(int) * MAX_JOBS);
+    memset(job_ready, 0, sizeof(int) * MAX_JOBS);
+    memset(machine_ready, 0, sizeof(int) * MAX_MACHINES);
+    for (int k = 0; k < depth; k++) {
+        int j = path[k], i = job_progress[j]++;
+        int m = ops_backup[j][i].machine;
+        int start = machine_ready[m] > job_ready[j] ? machine_ready[m] : job_ready[j];
+        machine_ready[m] = job_ready[j] = start + ops_backup[j][i].duration;
+    }
+}
+
+void encode_unit(uint8_t *unit, const int *path, int depth) {
+    int job_progress[MAX_JOBS], job_ready[MAX_JOBS], machine_ready[MAX_MACHINES];
+    replay_path(path, depth, job_progress, job_ready, machine_ready);
+    if (node_encode(&codec, unit, job_progress, job_ready, machine_ready, path, depth) < 0) {
+        fprintf(stderr, "Work unit does not fit the node encoding\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+    Restores the node of a unit: state arrays and schedule (node_codec.h),
+    then the time windows, scheduling the path in order. Returns the depth,
+    or -1 when the node cannot beat the incumbent.
+*/
+int load_unit(const uint8_t *unit, SearchNode *node, PropState *prop, int *path) {
+    memcpy(node->schedule, ops_local, sizeof(node->schedule));
+    int depth = node_decode_state(&codec, unit, node->job_progress, node->job_ready, node->machine_ready);
+    node_decode_path(&codec, unit, path);
+    if (node_rebuild_schedule(&codec, unit, &node->schedule[0][0], MAX_OPS) != 0) {
+        fprintf(stderr, "Corrupt work unit\n");
+        exit(EXIT_FAILURE);
+    }
+    int best = par_incumbent_get(&best_makespan);
+    if (prop_init(prop, SCHEDULE_VIEW(ops_local, num_jobs, num_ops, num_machines), total_work) < 0 ||
+        prop_set_horizon(prop, best - 1) < 0) return -1;
+    int progress[MAX_JOBS] = {0};
+    for (int k = 0; k < depth; k++) {
+        int j = path[k], i = progress[j]++;
+        if (prop_schedule(prop, j, i, node->schedule[j][i].start) < 0) return -1;
+    }
+    return prop_lower_bound(prop) < best ? depth : -1;
+}
+
+/*
+    Master: expands the root level by level (children in --order, pruned
+    like any node) until there are MPI_UNITS_PER_WORKER units per worker,
+    and queues them so the first in heuristic order goes out first.
+*/
+void build_frontier(void) {
+    static uint8_t level[2][MPI_FRONTIER_UNITS][MPI_MAX_UNIT_BYTES];
+    static SearchNode node;
+    int path[MAX_JOBS * MAX_OPS] = {0}, order[MAX_JOBS];
+    int count = 1, cur = 0, depth = 0;
+    encode_unit(level[0][0], path, 0);
+    ops_local = ops_backup;
+    PropState *prop = &prop_states[par_worker_id()];
+    while (count > 0 && count < MPI_UNITS_PER_WORKER * distributed && depth < num_jobs * num_ops) {
+        int next = 0, full = 0;
+        for (int u = 0; u < count && !full; u++) {
+            if (load_unit(level[cur][u], &node, prop, path) < 0) continue;
+            int last_job = depth > 0 ? path[depth - 1] : -1;
+            int n = order_children(prop, last_job, node.job_progress, node.job_ready, node.machine_ready,
+                                   node.schedule, par_incumbent_get(&best_makespan), order);
+            if (next + n > MPI_FRONTIER_UNITS) { full = 1; break; }
+            for (int c = 0; c < n; c++) {
+                path[depth] = order[c];
+                encode_unit(level[!cur][next++], path, depth + 1);
+            }
+        }
+        if (full) break;
+        cur = !cur;
+        count = next;
+        depth++;
+    }
+    for (int u = count - 1; u >= 0; u--) mpi_queue_unit(level[cur][u]);
+    frontier_units = count;
+    frontier_depth = depth;
+}
+
+// Worker hooks (mpi_work): one unit searched to the end with the shared incumbent.
+void mpi_search_unit(const uint8_t *unit, void *ctx) {
+    (void)ctx;
+    select_replica();
+    ArenaPool *pool = &node_pools[par_worker_id()];
+    if (!pool->arena) arena_pool_init(pool, &arenas[par_worker_id()], sizeof(SearchNode));
+    SearchNode *node = arena_pool_alloc(pool);
+    if (!node) { fprintf(stderr, "Arena exhausted (ARENA_REGION_BYTES)\n"); exit(EXIT_FAILURE); }
+    PropState *prop = &prop_states[par_worker_id()];
+    int depth = load_unit(unit, node, prop, unit_path);
+    if (depth >= 0) {
+        int makespan = 0;
+        for (int j = 0; j < num_jobs; j++) if (node->job_ready[j] > makespan) makespan = node->job_ready[j];
+        unit_depth = depth;
+        branch_and_bound(depth, makespan, NO_DISCREPANCY_LIMIT, depth > 0 ? unit_path[depth - 1] : -1,
+                         node->job_progress, node->job_ready, node->machine_ready, node->schedule);
+        unit_depth = -1;
+    }
+    arena_pool_free(pool, node);
+}
+
+void mpi_improve(int makespan, void *ctx) {
+    (void)ctx;
+    par_incumbent_improve(&best_makespan, makespan);
+}
+
+/*
+    Gives away the untried children of the shallowest frame that has some
+    (and enough operations left to be worth a message), last ones first;
+    the frame stops before them.
+*/
+int mpi_split(uint8_t *units, int max_units, void *ctx) {
+    (void)ctx;
+    if (unit_depth < 0) return 0;
+    int path[MAX_JOBS * MAX_OPS];
+    memcpy(path, unit_path, sizeof(int) * unit_depth);
+    int total = num_jobs * num_ops;
+    SplitFrame *stack = split_stacks[par_worker_id()];   // called from mpi_poll() in the unit's search
+    for (int d = unit_depth; d < total && stack[d].order; d++) {
+        SplitFrame *f = &stack[d];
+        if (f->n - f->c > 1 && total - d - 1 >= SPLIT_MIN_REMAINING) {
+            int count = 0;
+            while (f->n - f->c > 1 && count < max_units) {
+                path[d] = f->order[--f->n];
+                encode_unit(units + count++ * mpi_unit_bytes(), path, d + 1);
+            }
+            return count;
+        }
+        path[d] = f->order[f->c];
+    }
+    return 0;
+}
+
+/*
+    Complete search over all ranks. The master builds the frontier from its
+    incumbent and serves it (mpi_serve); the workers search units until
+    stopped. Afterwards every rank gets the best schedule from the rank
+    that found it.
+*/
+void distributed_search(double t0, int verbose) {
+    static const MpiWorkerHooks hooks = { mpi_search_unit, mpi_improve, mpi_split, NULL };
+    if (mpi_rank() == 0) build_frontier();
+    int bound = mpi_share_bound(par_incumbent_get(&best_makespan));
+    if (mpi_rank() == 0) {
+        if (verbose) {
+            printf("[MPI] %d workers | %d units at depth %d | Best=%d | Elapsed=%.2fs\n",
+                   distributed, frontier_units, frontier_depth, bound, par_time() - t0);
+            fflush(stdout);
+        }
+        mpi_serve(bound);
+    }
+    else {
+        par_incumbent_improve(&best_makespan, bound);
+        mpi_work(&hooks);
+    }
+
+    int best;
+    int owner = mpi_owner_of_best(current_best_live, &best);
+    if (best < INT_MAX) {
+        mpi_broadcast_bytes(best_schedule, sizeof(best_schedule), owner);
+        if (owner != 0) events_incumbent(EVENTS_CONTROL, best);   // found by a worker rank
+        par_incumbent_init(&best_makespan, best);
+        current_best_live = best;
+    }
+}
+
+/*
+    Per-rank statistics to the master, and the node / pruning / propagation
+    counters summed over all ranks into slot 0 (the "Nodes" and
+    "Propagation" lines of write_output then cover the whole run).
+*/
+void collect_rank_stats(double wall_time) {
+    enum { FIELDS = 9 };
+    unsigned long long totals[FIELDS] = {0};
+    for (int w = 0; w < PAR_MAX_SLOTS; w++) {
+        unsigned long long v[FIELDS] = { step_counts[w].steps, step_counts[w].pruned_bound, step_counts[w].pruned_append,
+                                         step_counts[w].pruned_commute, step_counts[w].pruned_left_shift,
+                                         prop_states[w].calls, prop_states[w].failures,
+                                         prop_states[w].est_updates, prop_states[w].lct_updates };
+        for (int f = 0; f < FIELDS; f++) totals[f] += v[f];
+    }
+    mpi_stats()->nodes = totals[0];
+    mpi_stats()->wall_time = wall_time;
+    mpi_gather_stats(rank_stats);
+    mpi_sum_counters(totals, FIELDS);
+    if (mpi_rank() > 0) return;
+    reset_counters();
+    step_counts[0].steps = totals[0];
+    step_counts[0].pruned_bound = totals[1];
+    step_counts[0].pruned_append = totals[2];
+    step_counts[0].pruned_commute = totals[3];
+    step_counts[0].pruned_left_shift = totals[4];
+    prop_states[0].calls = totals[5];
+    prop_states[0].failures = totals[6];
+    prop_states[0].est_updates = totals[7];
+    prop_states[0].lct_updates = totals[8];
+}
+#endif
+
+// Nodes expanded so far by every worker (sampled by the event emitter)
+unsigned long long total_steps(void) {
+    unsigned long long total = 0;
+    for (int w = 0; w < PAR_MAX_SLOTS; w++) total += step_counts[w].steps;
+    return total;
+}
+
+/*
+    Without --lds: one complete search. With --lds=K: passes with at most
+    0, 1, ..., K discrepancies find strong incumbents early, then the
+    complete search proves optimality with them. With --bisect the passes
+    (at least pass 0, more until one finds a schedule) give the upper bound
+    and bisect() replaces the complete search. With MPI ranks the master
+    runs the passes (at least pass 0, for the frontier's incumbent) and
+    distributed_search() replaces the complete search.
+*/
+double measure_execution(int repeats) {
     double total = 0.0;
     for (int r = 0; r < repeats; r++) {
-        best_makespan = INT_MAX;
+        par_incumbent_init(&best_makespan, INT_MAX);
         current_best_live = INT_MAX;
-        double t0 = omp_get_wtime();
-
-        #pragma omp parallel num_threads(threads)
-        {
-            #pragma omp for schedule(dynamic)
-            for (int seed_job = 0; seed_job < num_jobs; seed_job++) {
-                int job_progress[MAX_JOBS] = {0};
-                int job_ready[MAX_JOBS] = {0};
-                int machine_ready[MAX_MACHINES] = {0};
-                Operation current_schedule[MAX_JOBS][MAX_OPS] = {{{0}}};
-
-                int m = ops_backup[seed_job][0].machine;
-                int d = ops_backup[seed_job][0].duration;
-                current_schedule[seed_job][0].machine = m;
-                current_schedule[seed_job][0].duration = d;
-                current_schedule[seed_job][0].start = 0;
-                current_schedule[seed_job][0].end = d;
-                machine_ready[m] = d;
-                job_ready[seed_job] = d;
-                job_progress[seed_job] = 1;
-
-                branch_and_bound(1, d, job_progress, job_ready, machine_ready, current_schedule);
+        bisect_rounds = 0;
+        memset(probe_counts, 0, sizeof(probe_counts));
+        // the output reports the last repetition: counters, arenas and ranks
+        reset_counters();
+        arena_reset_all();   // the previous repetition's nodes, in bulk
+        arena_reset_stats(arenas, PAR_MAX_SLOTS);
+#ifdef JSS_MPI
+        memset(mpi_stats(), 0, sizeof(MpiRankStats));
+#endif
+        double t0 = par_time();
+        events_phase("repeat", r + 1);
+
+        for (int pass = 0; ; pass++) {
+            int heuristic = pass <= lds_passes ||
+                            (bisect_probes > 0 && par_incumbent_get(&best_makespan) == INT_MAX) ||
+                            (distributed && pass == 0);
+            int budget = heuristic ? pass : NO_DISCREPANCY_LIMIT;
+            if (heuristic) events_phase("lds_pass", pass);
+            else events_phase(distributed ? "distributed" : bisect_probes > 0 ? "bisect" : "complete", -1);
+#ifdef JSS_MPI
+            if (distributed && (budget == NO_DISCREPANCY_LIMIT || mpi_rank() > 0)) {
+                distributed_search(t0, r == 0);
+                break;
+            }
+#endif
+            if (budget == NO_DISCREPANCY_LIMIT && bisect_probes > 0) {
+                bisect(t0, r == 0);
+                break;
+            }
+            order_seed_jobs();
+            par_for(num_seeds, 1, search_seed_jobs, &budget);
+            if (budget == NO_DISCREPANCY_LIMIT || interrupted) break;
+            if (r == 0) {
+                printf("[LDS] pass %d | Best=%d | Elapsed=%.2fs\n", pass, current_best_live, par_time() - t0);
+                fflush(stdout);
             }
         }
 
-        double t1 = omp_get_wtime();
+        // Runs that end without an interrupt prove the incumbent optimal
+        if (!interrupted) {
+            events_lower_bound(EVENTS_CONTROL, par_incumbent_get(&best_makespan));
+            events_phase("done", r + 1);
+        }
+        double t1 = par_time();
         total += (t1 - t0);
+        if (interrupted) break;
     }
     return total / repeats;
 }
 
 int main(int argc, char *argv[]) {
+#ifdef JSS_MPI
+    mpi_search_init(&argc, &argv);
+    distributed = mpi_size() - 1;
+#endif
     if (argc < 5) {
-        fprintf(stderr, "Usage: %s input.jss output.txt threads repeats\n", argv[0]);
+        fprintf(stderr, "Usage: %s input.jss output.txt threads repeats [--gantt[=N]] [--binary=FILE] [--backend=omp|pool|seq] [--pin]\n"
+                        "       [--order=job|est|ect|mwr|lb] [--lds[=K]] [--dominance=off|commute|shift|all] [--bisect[=K]] [--kernel=generic]\n"
+                        "       [--events=FILE] [--events-interval=SEC]\n", argv[0]);
         return EXIT_FAILURE;
     }
 
+    int gantt_resolution = 0;
+    const char *binary_filename = NULL;
+    ParBackend backend = par_default_backend();
+    int generic_kernel = 0;
+    const char *events_filename = NULL;
+    double events_interval = 1.0;
+    for (int a = 5; a < argc; a++) {
+        if (strcmp(argv[a], "--gantt") == 0) gantt_resolution = 5;
+        else if (strncmp(argv[a], "--gantt=", 8) == 0) gantt_resolution = atoi(argv[a] + 8);
+        else if (strncmp(argv[a], "--binary=", 9) == 0) binary_filename = argv[a] + 9;
+        else if (strcmp(argv[a], "--pin") == 0) par_set_pinning(1);
+        else if (strcmp(argv[a], "--kernel=generic") == 0) generic_kernel = 1;
+        else if (strncmp(argv[a], "--events=", 9) == 0) events_filename = argv[a] + 9;
+        else if (strncmp(argv[a], "--events-interval=", 18) == 0) events_interval = atof(argv[a] + 18);
+        else if (strcmp(argv[a], "--lds") == 0) lds_passes = 3;
+        else if (strncmp(argv[a], "--lds=", 6) == 0) lds_passes = atoi(argv[a] + 6);
+        else if (strcmp(argv[a], "--bisect") == 0) bisect_probes = -1;
+        else if (strncmp(argv[a], "--bisect=", 9) == 0) bisect_probes = atoi(argv[a] + 9);
+        else if (strcmp(argv[a], "--dominance=off") == 0) dominance = 0;
+        else if (strcmp(argv[a], "--dominance=commute") == 0) dominance = DOMINANCE_COMMUTE;
+        else if (strcmp(argv[a], "--dominance=shift") == 0) dominance = DOMINANCE_SHIFT;
+        else if (strcmp(argv[a], "--dominance=all") == 0) dominance = DOMINANCE_COMMUTE | DOMINANCE_SHIFT;
+        else if (strncmp(argv[a], "--order=", 8) == 0) {
+            int o = 0;
+            while (o <= ORDER_LB && strcmp(argv[a] + 8, order_names[o]) != 0) o++;
+            if (o > ORDER_LB) {
+                fprintf(stderr, "Unknown child order: %s\n", argv[a] + 8);
+                return EXIT_FAILURE;
+            }
+            child_order = (ChildOrder)o;
+        }
+        else if (strncmp(argv[a], "--backend=", 10) == 0) {
+            if (par_parse_backend(argv[a] + 10, &backend) != 0) {
+                fprintf(stderr, "Unknown backend: %s\n", argv[a] + 10);
+                return EXIT_FAILURE;
+            }
+        }
+        else { fprintf(stderr, "Unknown option: %s\n", argv[a]); return EXIT_FAILURE; }
+    }
+
     signal(SIGINT, handle_interrupt);
-    program_start_time = omp_get_wtime();
+    program_start_time = par_time();
     read_input(argv[1]);
+    kernels = generic_kernel ? shape_kernels_generic() : shape_kernels_select(num_jobs, num_machines);
+#ifdef JSS_MPI
+    if (distributed) {
+        if (bisect_probes != 0) {
+            fprintf(stderr, "--bisect runs on one rank (start it without mpirun or with -np 1)\n");
+            return EXIT_FAILURE;
+        }
+        if (distributed >= MPI_MAX_RANKS || node_codec_init(&codec, num_jobs, num_ops, num_machines) != 0 ||
+            node_max_bytes(&codec) > MPI_MAX_UNIT_BYTES) {
+            fprintf(stderr, "Too many ranks or instance too large for MPI work units\n");
+            return EXIT_FAILURE;
+        }
+        mpi_set_unit_bytes((int)node_max_bytes(&codec));
+    }
+#endif
 
     int threads = atoi(argv[3]);
     int repeats = atoi(argv[4]);
@@ -260,8 +1116,50 @@ int main(int argc, char *argv[]) {
         return EXIT_FAILURE;
     }
 
-    double avg_time = measure_execution(threads, repeats);
-    write_output(argv[2], avg_time, repeats, argv[1]);
+    if (par_init(backend, threads) != 0) {
+        fprintf(stderr, "Backend %s is not available in this build.\n", par_backend_name(backend));
+        return EXIT_FAILURE;
+    }
+    if (bisect_probes < 0) bisect_probes = par_threads();
+    if (bisect_probes > MAX_PROBES) bisect_probes = MAX_PROBES;
+#ifdef JSS_MPI
+    if (mpi_rank() > 0) events_filename = NULL;   // the master streams the run
+#endif
+    if (events_filename && events_open(events_filename, events_interval, total_steps) != 0) {
+        fprintf(stderr, "Cannot open event stream %s\n", events_filename);
+        return EXIT_FAILURE;
+    }
+    // Root propagation bound: an interrupted run reports it with the incumbent
+    atomic_store(&lower_bound_live, root_lower_bound(total_work));
+    double avg_time = measure_execution(repeats);
+#ifdef JSS_MPI
+    if (distributed) interrupted = mpi_any(interrupted);   // every rank takes the same exit
+#endif
+    if (interrupted) {
+#ifdef JSS_MPI
+        if (mpi_rank() == 0)   // the master reports for every rank
+#endif
+        write_interrupted_output();
+        events_phase("interrupted", -1);
+        events_close();
+        par_shutdown();
+#ifdef JSS_MPI
+        mpi_search_finalize();
+#endif
+        return EXIT_FAILURE;
+    }
+    events_close();
+    assert_valid_schedule(SCHEDULE_VIEW(best_schedule, num_jobs, num_ops, num_machines),
+                          &SCHEDULE_VIEW(ops_backup, num_jobs, num_ops, num_machines), "branch_and_bound");
+#ifdef JSS_MPI
+    if (distributed) collect_rank_stats(avg_time);
+    if (mpi_rank() == 0)
+#endif
+    write_output(argv[2], avg_time, repeats, argv[1], gantt_resolution, binary_filename);
+    par_shutdown();
+#ifdef JSS_MPI
+    mpi_search_finalize();
+#endif
     return EXIT_SUCCESS;
 }
 
@@ -0,0 +1,353 @@
+/*
+    MPI master/worker distribution of branch-and-bound units (see mpi_search.h).
+*/
+
+#include <mpi.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "mpi_search.h"
+
+enum { TAG_REQUEST = 1, TAG_WORK, TAG_STOP, TAG_INCUMBENT, TAG_SPLIT, TAG_DONATE };
+
+static int rank, size;
+static int unit_bytes = MPI_MAX_UNIT_BYTES;
+static MpiRankStats stats;
+
+static uint8_t queue[MPI_MAX_UNITS][MPI_MAX_UNIT_BYTES];   // master: LIFO, donations go out first
+static int queued;
+
+static const MpiWorkerHooks *hooks;                         // worker: set by mpi_work()
+static uint8_t donation[MPI_MAX_MESSAGE_BYTES];
+
+// The solver's threads never call MPI: only the thread that called this one does.
+int mpi_search_init(int *argc, char ***argv) {
+    int provided;
+    MPI_Init_thread(argc, argv, MPI_THREAD_FUNNELED, &provided);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    if (provided < MPI_THREAD_FUNNELED) {
+        if (rank == 0) fprintf(stderr, "MPI library without MPI_THREAD_FUNNELED support\n");
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    return rank;
+}
+
+void mpi_search_finalize(void) { MPI_Finalize(); }
+int mpi_rank(void) { return rank; }
+int mpi_size(void) { return size; }
+void mpi_set_unit_bytes(int bytes) { unit_bytes = bytes; }
+int mpi_unit_bytes(void) { return unit_bytes; }
+MpiRankStats *mpi_stats(void) { return &stats; }
+
+// ================== Counted point-to-point ==================
+/*
+    Sends are MPI_Isend from a copy in an outbox slot; outbox_progress()
+    completes them from the serve loop, mpi_poll() and the workers' wait
+    for work, and outbox_flush() before leaving mpi_serve()/mpi_work(). A
+    send only waits when every slot is in flight, which the protocol
+    bounds: per worker the master has at most one WORK, SPLIT, INCUMBENT
+    and STOP in flight (relayed incumbents are coalesced, see
+    relay_incumbent()), a worker one REQUEST or DONATE plus its own
+    incumbents, and the master keeps receiving until every worker is idle.
+*/
+typedef struct {
+    int to, tag;
+    uint8_t data[MPI_MAX_MESSAGE_BYTES];
+} OutboxSlot;
+
+static OutboxSlot outbox[MPI_OUTBOX_SLOTS];
+static MPI_Request outbox_requests[MPI_OUTBOX_SLOTS];
+static int outbox_free[MPI_OUTBOX_SLOTS], outbox_num_free = -1;   // -1: not set up yet
+static int relay_slot[MPI_MAX_RANKS];      // master: INCUMBENT in flight to each worker, -1: none
+static int relay_waiting[MPI_MAX_RANKS];   // master: newer value to send once it completes, INT_MAX: none
+
+static void outbox_init(void) {
+    for (int slot = 0; slot < MPI_OUTBOX_SLOTS; slot++) {
+        outbox_requests[slot] = MPI_REQUEST_NULL;
+        outbox_free[slot] = MPI_OUTBOX_SLOTS - 1 - slot;
+    }
+    outbox_num_free = MPI_OUTBOX_SLOTS;
+    for (int w = 0; w < MPI_MAX_RANKS; w++) {
+        relay_slot[w] = -1;
+        relay_waiting[w] = INT_MAX;
+    }
+}
+
+static void release(int slot) {
+    if (outbox[slot].tag == TAG_INCUMBENT && relay_slot[outbox[slot].to] == slot) relay_slot[outbox[slot].to] = -1;
+    outbox_free[outbox_num_free++] = slot;
+}
+
+// Returns the slot of the new send.
+static int send(const void *data, int bytes, int to, int tag) {
+    double t0 = MPI_Wtime();
+    if (outbox_num_free < 0) outbox_init();
+    if (outbox_num_free == 0) {   // beyond the protocol's bound: wait for any send to complete
+        int done;
+        MPI_Waitany(MPI_OUTBOX_SLOTS, outbox_requests, &done, MPI_STATUS_IGNORE);
+        release(done);
+    }
+    int slot = outbox_free[--outbox_num_free];
+    OutboxSlot *o = &outbox[slot];
+    o->to = to;
+    o->tag = tag;
+    if (bytes > 0) memcpy(o->data, data, bytes);
+    MPI_Isend(o->data, bytes, MPI_BYTE, to, tag, MPI_COMM_WORLD, &outbox_requests[slot]);
+    stats.comm_time += MPI_Wtime() - t0;
+    stats.sent++;
+    stats.bytes_sent += bytes;
+    return slot;
+}
+
+// Master: sends value to worker w, or keeps it until w's previous relay completed.
+static void relay_incumbent(int value, int w) {
+    if (relay_slot[w] >= 0) relay_waiting[w] = value;   // replaces an older waiting value
+    else relay_slot[w] = send(&value, sizeof(int), w, TAG_INCUMBENT);
+}
+
+// Gives the slots of completed sends back, then sends the relays that waited for them.
+static void outbox_progress(void) {
+    static int done[MPI_OUTBOX_SLOTS];
+    if (outbox_num_free < 0 || outbox_num_free == MPI_OUTBOX_SLOTS) return;
+    int n;
+    MPI_Testsome(MPI_OUTBOX_SLOTS, outbox_requests, &n, done, MPI_STATUSES_IGNORE);
+    if (n == MPI_UNDEFINED) return;
+    for (int k = 0; k < n; k++) release(done[k]);
+    for (int w = 1; w < size && rank == 0; w++) {
+        if (relay_slot[w] >= 0 || relay_waiting[w] == INT_MAX) continue;
+        int value = relay_waiting[w];
+        relay_waiting[w] = INT_MAX;
+        relay_slot[w] = send(&value, sizeof(int), w, TAG_INCUMBENT);
+    }
+}
+
+// Completes every send (relays still waiting are dropped: the search is over).
+static void outbox_flush(void) {
+    if (outbox_num_free < 0) return;
+    double t0 = MPI_Wtime();
+    MPI_Waitall(MPI_OUTBOX_SLOTS, outbox_requests, MPI_STATUSES_IGNORE);
+    outbox_init();
+    stats.comm_time += MPI_Wtime() - t0;
+}
+
+// Blocking receive; the wait counts as idle time.
+static int receive(void *data, int capacity, int from, MPI_Status *status) {
+    double t0 = MPI_Wtime();
+    MPI_Recv(data, capacity, MPI_BYTE, from, MPI_ANY_TAG, MPI_COMM_WORLD, status);
+    stats.idle_time += MPI_Wtime() - t0;
+    int bytes;
+    MPI_Get_count(status, MPI_BYTE, &bytes);
+    stats.received++;
+    stats.bytes_received += bytes;
+    return bytes;
+}
+
+// Waits until a message is pending or MPI_Wtime() reaches deadline; 0 on
+// timeout. The wait counts as idle time.
+static int wait_for_message(double deadline, MPI_Status *status) {
+    const struct timespec pause = { 0, 200000 };   // 0.2 ms between probes
+    double t0 = MPI_Wtime();
+    int flag;
+    for (;;) {
+        MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, status);
+        if (flag || MPI_Wtime() >= deadline) break;
+        nanosleep(&pause, NULL);
+    }
+    stats.idle_time += MPI_Wtime() - t0;
+    return flag;
+}
+
+// Units per DONATE message: the whole message fits an outbox slot.
+static int max_donation(void) {
+    int n = MPI_MAX_MESSAGE_BYTES / unit_bytes;
+    return n < MPI_MAX_DONATION ? n : MPI_MAX_DONATION;
+}
+
+// ================== Master ==================
+int mpi_queue_unit(const uint8_t *unit) {
+    if (queued == MPI_MAX_UNITS) return -1;
+    memcpy(queue[queued++], unit, unit_bytes);
+    return 0;
+}
+
+int mpi_queued_units(void) { return queued; }
+
+int mpi_serve(int incumbent) {
+    enum { STARTING, BUSY, IDLE };
+    static int state[MPI_MAX_RANKS], split_pending[MPI_MAX_RANKS];
+    static unsigned assigned[MPI_MAX_RANKS], split_at[MPI_MAX_RANKS];   // units handed out, at the last SPLIT
+    static double retry_at[MPI_MAX_RANKS];   // no SPLIT before this time (0: none pending)
+    static uint8_t message[MPI_MAX_MESSAGE_BYTES];
+    int idle = 0, pending = 0;
+    for (int w = 1; w < size; w++) { state[w] = STARTING; split_pending[w] = 0; retry_at[w] = 0; }
+
+    // Every worker starts with a REQUEST: none is idle (or splittable) before it
+    while (idle < size - 1 || pending > 0 || queued > 0) {
+        // Workers wait while busy ones are backing off: wake up when the first may be asked again
+        double retry = 0;
+        for (int w = 1; w < size && pending < idle; w++)
+            if (state[w] == BUSY && !split_pending[w] && retry_at[w] > 0 && (retry == 0 || retry_at[w] < retry))
+                retry = retry_at[w];
+        MPI_Status status;
+        if (retry == 0 || wait_for_message(retry, &status)) {
+            int bytes = receive(message, sizeof(message), MPI_ANY_SOURCE, &status);
+            int from = status.MPI_SOURCE;
+            switch (status.MPI_TAG) {
+            case TAG_REQUEST:
+                state[from] = IDLE;
+                idle++;
+                break;
+            case TAG_INCUMBENT: {
+                int value;
+                memcpy(&value, message, sizeof(int));
+                if (value < incumbent) {
+                    incumbent = value;
+                    for (int w = 1; w < size; w++)
+                        if (w != from) relay_incumbent(incumbent, w);
+                }
+                break;
+            }
+            case TAG_DONATE: {
+                split_pending[from] = 0;
+                pending--;
+                int n = bytes / unit_bytes;
+                // Nothing to split: ask again after a backoff, or as soon as it gets new
+                // work (an empty answer from its idle loop says nothing about a unit
+                // handed out since)
+                if (n == 0 && assigned[from] == split_at[from]) retry_at[from] = MPI_Wtime() + MPI_SPLIT_BACKOFF;
+                else if (n > 0) retry_at[from] = 0;
+                for (int u = 0; u < n; u++) mpi_queue_unit(message + u * unit_bytes);
+                stats.donated += n;
+                break;
+            }
+            }
+        }
+
+        outbox_progress();
+        // Hand out queued units, then ask busy workers for more if some still wait
+        for (int w = 1; w < size && queued > 0; w++) {
+            if (state[w] != IDLE) continue;
+            send(queue[--queued], unit_bytes, w, TAG_WORK);
+            state[w] = BUSY;
+            retry_at[w] = 0;
+            assigned[w]++;
+            idle--;
+            stats.units++;
+        }
+        double t = MPI_Wtime();
+        for (int w = 1; w < size && pending < idle; w++) {
+            if (state[w] != BUSY || split_pending[w] || t < retry_at[w]) continue;
+            send(NULL, 0, w, TAG_SPLIT);
+            split_pending[w] = 1;
+            split_at[w] = assigned[w];
+            pending++;
+        }
+        if (idle == size - 1 && pending == 0 && queued == 0) break;
+    }
+    for (int w = 1; w < size; w++) send(NULL, 0, w, TAG_STOP);
+    outbox_flush();
+    return incumbent;
+}
+
+// ================== Workers ==================
+// Answers a SPLIT: open subproblems of the current search (none when idle).
+static void donate(int searching) {
+    int n = searching ? hooks->split(donation, max_donation(), hooks->ctx) : 0;
+    stats.donated += n;
+    send(donation, n * unit_bytes, 0, TAG_DONATE);
+}
+
+void mpi_work(const MpiWorkerHooks *h) {
+    static uint8_t message[MPI_MAX_UNIT_BYTES];
+    hooks = h;
+    send(NULL, 0, 0, TAG_REQUEST);
+    for (;;) {
+        MPI_Status status;
+        receive(message, sizeof(message), 0, &status);
+        if (status.MPI_TAG == TAG_STOP) break;
+        if (status.MPI_TAG == TAG_INCUMBENT) {
+            int value;
+            memcpy(&value, message, sizeof(int));
+            hooks->improve(value, hooks->ctx);
+        }
+        else if (status.MPI_TAG == TAG_SPLIT) donate(0);
+        else if (status.MPI_TAG == TAG_WORK) {
+            double t0 = MPI_Wtime();
+            hooks->search(message, hooks->ctx);
+            stats.search_time += MPI_Wtime() - t0;
+            stats.units++;
+            outbox_progress();
+            send(NULL, 0, 0, TAG_REQUEST);
+        }
+    }
+    outbox_flush();
+    hooks = NULL;
+}
+
+void mpi_poll(void) {
+    if (!hooks) return;
+    double t0 = MPI_Wtime();
+    int flag;
+    MPI_Status status;
+    MPI_Iprobe(0, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, &status);
+    while (flag) {
+        int value = 0, bytes;
+        MPI_Get_count(&status, MPI_BYTE, &bytes);
+        MPI_Recv(&value, sizeof(int), MPI_BYTE, 0, status.MPI_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        stats.received++;
+        stats.bytes_received += bytes;
+        if (status.MPI_TAG == TAG_INCUMBENT) hooks->improve(value, hooks->ctx);
+        else if (status.MPI_TAG == TAG_SPLIT) donate(1);
+        MPI_Iprobe(0, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, &status);
+    }
+    outbox_progress();
+    stats.comm_time += MPI_Wtime() - t0;
+}
+
+void mpi_publish_incumbent(int makespan) {
+    if (size > 1 && rank > 0) send(&makespan, sizeof(int), 0, TAG_INCUMBENT);
+}
+
+// ================== Collectives ==================
+int mpi_share_bound(int value) {
+    double t0 = MPI_Wtime();
+    MPI_Bcast(&value, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    stats.comm_time += MPI_Wtime() - t0;
+    return value;
+}
+
+int mpi_any(int flag) {
+    int any;
+    double t0 = MPI_Wtime();
+    MPI_Allreduce(&flag, &any, 1, MPI_INT, MPI_LOR, MPI_COMM_WORLD);
+    stats.comm_time += MPI_Wtime() - t0;
+    return any;
+}
+
+int mpi_owner_of_best(int makespan, int *best) {
+    struct { int value, rank; } in = { makespan, rank }, out;
+    double t0 = MPI_Wtime();
+    MPI_Allreduce(&in, &out, 1, MPI_2INT, MPI_MINLOC, MPI_COMM_WORLD);
+    stats.comm_time += MPI_Wtime() - t0;
+    *best = out.value;
+    return out.rank;
+}
+
+void mpi_broadcast_bytes(void *data, int bytes, int root) {
+    double t0 = MPI_Wtime();
+    MPI_Bcast(data, bytes, MPI_BYTE, root, MPI_COMM_WORLD);
+    stats.comm_time += MPI_Wtime() - t0;
+}
+
+void mpi_sum_counters(unsigned long long *values, int count) {
+    double t0 = MPI_Wtime();
+    if (rank == 0) MPI_Reduce(MPI_IN_PLACE, values, count, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    else MPI_Reduce(values, NULL, count, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    stats.comm_time += MPI_Wtime() - t0;
+}
+
+void mpi_gather_stats(MpiRankStats *all) {
+    MPI_Gather(&stats, sizeof(stats), MPI_BYTE, all, sizeof(stats), MPI_BYTE, 0, MPI_COMM_WORLD);
+}
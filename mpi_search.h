@@ -0,0 +1,98 @@
+/*
+    Distributed-memory work distribution for the branch-and-bound over MPI.
+
+    Rank 0 is the master; every other rank is a worker that searches one
+    open subproblem (a work unit) at a time. A unit is an opaque byte slot
+    of mpi_unit_bytes() (the solver stores an encoded node, node_codec.h).
+
+    - Work: an idle worker sends REQUEST; the master answers with a unit
+      from its queue. When the queue is empty while workers wait, the master
+      sends SPLIT to busy workers, which donate open subproblems of their
+      current search (MpiWorkerHooks.split) back to the queue.
+    - Incumbents: a worker that finds a better schedule sends its makespan
+      to the master, which relays every improvement to the other workers.
+      Workers pick up relayed values and SPLIT requests in mpi_poll(),
+      called from the search every few thousand nodes, so no rank ever
+      blocks on another while searching.
+    - Termination: messages from one rank arrive in the order they were
+      sent, so when the master has a REQUEST from every worker, an empty
+      queue and no SPLIT unanswered, no work is left anywhere (donations
+      and incumbents sent before a REQUEST were already received). It then
+      sends STOP; relayed incumbents sent before STOP are drained by the
+      worker on the way.
+
+    No rank blocks in a send: messages go out with MPI_Isend from a copy
+    in an outbox slot and are completed while the rank polls or waits, so
+    two ranks sending to each other at the same time cannot deadlock,
+    whatever the transport's eager limit. Incumbents are an int, work
+    units at most MPI_MAX_UNIT_BYTES, and a DONATE answer carries as many
+    units as fit in MPI_MAX_MESSAGE_BYTES. A worker that had nothing to
+    split is asked again after MPI_SPLIT_BACKOFF seconds (its search may
+    have reached frames with untried children by then) or as soon as it
+    takes a new unit.
+
+    MPI runs with MPI_THREAD_FUNNELED: the search threads never call it,
+    only the thread that called mpi_search_init() (on workers units are
+    searched, and mpi_poll() called, by that thread alone).
+
+    Every rank counts its messages, bytes and the time spent in MPI calls
+    (comm) and blocked waiting for work or messages (idle); the solver adds
+    its node count before mpi_gather_stats().
+*/
+
+#ifndef MPI_SEARCH_H
+#define MPI_SEARCH_H
+
+#include <stdint.h>
+
+#define MPI_MAX_UNIT_BYTES    512
+#define MPI_MAX_UNITS         16384   // master queue
+#define MPI_MAX_DONATION      64      // units per SPLIT answer (fewer when they exceed a message)
+#define MPI_MAX_MESSAGE_BYTES 4000    // largest message (outbox slot size)
+#define MPI_SPLIT_BACKOFF     0.01    // seconds before asking a worker with nothing to split again
+#define MPI_MAX_RANKS         256
+#define MPI_OUTBOX_SLOTS      (4 * MPI_MAX_RANKS)   // sends in flight per rank
+
+typedef struct {
+    void (*search)(const uint8_t *unit, void *ctx);            // search one unit to the end
+    void (*improve)(int makespan, void *ctx);                  // incumbent relayed by the master
+    int  (*split)(uint8_t *units, int max_units, void *ctx);   // donate open subproblems; returns how many
+    void *ctx;
+} MpiWorkerHooks;
+
+typedef struct {
+    double wall_time;               // set by the solver
+    unsigned long long nodes;       // set by the solver
+    unsigned long long units;       // units searched (workers) / handed out (master)
+    unsigned long long donated;     // units given away on SPLIT (workers) / received (master)
+    unsigned long long sent, received, bytes_sent, bytes_received;
+    double search_time, comm_time, idle_time;
+} MpiRankStats;
+
+int  mpi_search_init(int *argc, char ***argv);   // returns the rank
+void mpi_search_finalize(void);
+int  mpi_rank(void);
+int  mpi_size(void);
+void mpi_set_unit_bytes(int bytes);
+int  mpi_unit_bytes(void);
+MpiRankStats *mpi_stats(void);   // counts since the caller last zeroed them
+
+// Master
+int  mpi_queue_unit(const uint8_t *unit);   // -1 when the queue is full
+int  mpi_queued_units(void);
+int  mpi_serve(int incumbent);              // runs until every worker is stopped; returns the best relayed makespan
+
+// Workers
+void mpi_work(const MpiWorkerHooks *hooks);
+void mpi_poll(void);
+void mpi_publish_incumbent(int makespan);
+
+// All ranks (collective)
+int  mpi_share_bound(int value);                // rank 0's value
+int  mpi_any(int flag);                         // nonzero on any rank
+int  mpi_owner_of_best(int makespan, int *best);   // rank with the smallest makespan (lowest rank on ties)
+void mpi_broadcast_bytes(void *data, int bytes, int root);
+void mpi_sum_counters(unsigned long long *values, int count);   // totals at rank 0
+void mpi_gather_stats(MpiRankStats *all);       // all[mpi_size()] at rank 0
+
+#endif
@@ -0,0 +1,136 @@
+/*
+    Compact node encoding (see node_codec.h).
+*/
+
+#include <string.h>
+#include "node_codec.h"
+
+#define NODE_BASE_BYTES 6   // int32 base + uint16 depth
+
+static int bits_for(int values) {   // bits to tell apart values 0..values-1
+    int b = 1;
+    while ((1 << b) < values) b++;
+    return b;
+}
+
+// LSB-first bit stream over a byte buffer; fields are at most 7 bits, so
+// each spans at most two bytes. put_bits() ORs into a zeroed buffer.
+static inline void put_bits(uint8_t *buf, size_t *pos, unsigned value, int bits) {
+    size_t byte = *pos >> 3;
+    int shift = (int)(*pos & 7);
+    buf[byte] |= (uint8_t)(value << shift);
+    if (shift + bits > 8) buf[byte + 1] |= (uint8_t)(value >> (8 - shift));
+    *pos += bits;
+}
+
+static inline unsigned get_bits(const uint8_t *buf, size_t *pos, int bits) {
+    size_t byte = *pos >> 3;
+    int shift = (int)(*pos & 7);
+    unsigned window = buf[byte];
+    if (shift + bits > 8) window |= (unsigned)buf[byte + 1] << 8;
+    *pos += bits;
+    return window >> shift & ((1u << bits) - 1);
+}
+
+int node_codec_init(NodeCodec *c, int num_jobs, int num_ops, int num_machines) {
+    if (num_jobs < 1 || num_jobs > NODE_MAX_JOBS || num_ops < 1 || num_ops > NODE_MAX_OPS ||
+        num_machines < 1 || num_machines > NODE_MAX_MACHINES) return -1;
+    c->num_jobs = num_jobs;
+    c->num_ops = num_ops;
+    c->num_machines = num_machines;
+    c->progress_bits = bits_for(num_ops + 1);
+    if (c->progress_bits < 4) c->progress_bits = 4;
+    c->job_bits = bits_for(num_jobs);
+    c->header_bytes = NODE_BASE_BYTES + 2 * (num_jobs + num_machines);
+    return 0;
+}
+
+size_t node_encoded_bytes(const NodeCodec *c, int depth) {
+    size_t bits = (size_t)c->num_jobs * c->progress_bits + (size_t)depth * c->job_bits;
+    return c->header_bytes + (bits + 7) / 8;
+}
+
+size_t node_max_bytes(const NodeCodec *c) {
+    return node_encoded_bytes(c, c->num_jobs * c->num_ops);
+}
+
+int node_encode(const NodeCodec *c, uint8_t *out, const int *job_progress, const int *job_ready,
+                const int *machine_ready, const int *path, int depth) {
+    int base = job_ready[0];
+    for (int j = 1; j < c->num_jobs; j++) if (job_ready[j] < base) base = job_ready[j];
+    for (int m = 0; m < c->num_machines; m++) if (machine_ready[m] < base) base = machine_ready[m];
+
+    int32_t base32 = base;
+    uint16_t depth16 = (uint16_t)depth;
+    memcpy(out, &base32, 4);
+    memcpy(out + 4, &depth16, 2);
+    uint8_t *delta = out + NODE_BASE_BYTES;
+    for (int k = 0; k < c->num_jobs + c->num_machines; k++) {
+        int d = (k < c->num_jobs ? job_ready[k] : machine_ready[k - c->num_jobs]) - base;
+        if (d > UINT16_MAX) return -1;
+        uint16_t d16 = (uint16_t)d;
+        memcpy(delta + 2 * k, &d16, 2);
+    }
+
+    uint8_t *bits = out + c->header_bytes;
+    size_t pos = 0;
+    memset(bits, 0, node_encoded_bytes(c, depth) - c->header_bytes);
+    for (int j = 0; j < c->num_jobs; j++) put_bits(bits, &pos, (unsigned)job_progress[j], c->progress_bits);
+    for (int k = 0; k < depth; k++) put_bits(bits, &pos, (unsigned)path[k], c->job_bits);
+    return (int)node_encoded_bytes(c, depth);
+}
+
+int node_decode_state(const NodeCodec *c, const uint8_t *in, int *job_progress, int *job_ready, int *machine_ready) {
+    int32_t base;
+    uint16_t depth;
+    memcpy(&base, in, 4);
+    memcpy(&depth, in + 4, 2);
+    const uint8_t *delta = in + NODE_BASE_BYTES;
+    for (int k = 0; k < c->num_jobs + c->num_machines; k++) {
+        uint16_t d;
+        memcpy(&d, delta + 2 * k, 2);
+        if (k < c->num_jobs) { if (job_ready) job_ready[k] = base + d; }
+        else if (machine_ready) machine_ready[k - c->num_jobs] = base + d;
+    }
+    if (job_progress) {
+        size_t pos = 0;
+        for (int j = 0; j < c->num_jobs; j++)
+            job_progress[j] = (int)get_bits(in + c->header_bytes, &pos, c->progress_bits);
+    }
+    return depth;
+}
+
+int node_decode_path(const NodeCodec *c, const uint8_t *in, int *path) {
+    uint16_t depth;
+    memcpy(&depth, in + 4, 2);
+    size_t pos = (size_t)c->num_jobs * c->progress_bits;
+    for (int k = 0; k < depth; k++) path[k] = (int)get_bits(in + c->header_bytes, &pos, c->job_bits);
+    return depth;
+}
+
+int node_rebuild_schedule(const NodeCodec *c, const uint8_t *in, Operation *table, int stride) {
+    int progress[NODE_MAX_JOBS], job_ready[NODE_MAX_JOBS], machine_ready[NODE_MAX_MACHINES];
+    int want_progress[NODE_MAX_JOBS], want_job[NODE_MAX_JOBS], want_machine[NODE_MAX_MACHINES];
+    node_decode_state(c, in, want_progress, want_job, want_machine);
+    for (int j = 0; j < c->num_jobs; j++) progress[j] = job_ready[j] = 0;
+    for (int m = 0; m < c->num_machines; m++) machine_ready[m] = 0;
+
+    uint16_t depth;
+    memcpy(&depth, in + 4, 2);
+    size_t pos = (size_t)c->num_jobs * c->progress_bits;
+    for (int k = 0; k < depth; k++) {
+        int j = (int)get_bits(in + c->header_bytes, &pos, c->job_bits);
+        if (j >= c->num_jobs || progress[j] >= c->num_ops) return -1;
+        Operation *op = &table[j * stride + progress[j]++];
+        int m = op->machine;
+        op->start = machine_ready[m] > job_ready[j] ? machine_ready[m] : job_ready[j];
+        op->end = op->start + op->duration;
+        job_ready[j] = machine_ready[m] = op->end;
+    }
+
+    for (int j = 0; j < c->num_jobs; j++)
+        if (progress[j] != want_progress[j] || job_ready[j] != want_job[j]) return -1;
+    for (int m = 0; m < c->num_machines; m++)
+        if (machine_ready[m] != want_machine[m]) return -1;
+    return 0;
+}
@@ -0,0 +1,58 @@
+/*
+    Compact encoding of branch-and-bound nodes for frontier-based search.
+
+    A V6 node is its partial schedule plus job_progress, job_ready and
+    machine_ready: about 1.7 KB for a 10x10 (MAX_OPS rows of Operation).
+    Every start/end follows from the decisions taken since the root (V6
+    appends each operation at max(machine ready, job ready)), so a frontier
+    node only has to keep what the bound needs plus the decision path:
+
+        int32   base          min of all ready times
+        uint16  depth         operations scheduled (path length)
+        uint16  ready[]       job_ready[0..J) then machine_ready[0..M), minus base
+        bits    progress[]    job_progress, progress_bits (4..7) per job
+        bits    path[]        job of every decision, job_bits per entry
+
+    padded to a whole byte: 101 bytes for a 10x10 node at full depth. A
+    ready time more than 65535 past the base does not fit a delta, and
+    node_encode() refuses the node (the caller keeps it in full form).
+
+    node_decode_state() restores the arrays the bound reads without touching
+    the path; node_rebuild_schedule() replays the path over the instance
+    table (passed as &table[0][0] plus its row stride, like ScheduleView)
+    and checks the result against the stored state.
+*/
+
+#ifndef NODE_CODEC_H
+#define NODE_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "jobshop.h"
+
+#define NODE_MAX_JOBS     128   // 7-bit path entries
+#define NODE_MAX_OPS      127   // 7-bit progress
+#define NODE_MAX_MACHINES JSS_MAX_MACHINES
+
+typedef struct {
+    int num_jobs, num_ops, num_machines;
+    int progress_bits;          // bits per job_progress entry (4..7)
+    int job_bits;               // bits per path entry
+    int header_bytes;           // base, depth and the 16-bit deltas
+} NodeCodec;
+
+int    node_codec_init(NodeCodec *c, int num_jobs, int num_ops, int num_machines);   // -1 if the shape does not fit
+size_t node_encoded_bytes(const NodeCodec *c, int depth);
+size_t node_max_bytes(const NodeCodec *c);   // a node at full depth: the slot size of a fixed-size frontier
+
+// Returns the bytes written, or -1 when a ready time does not fit a 16-bit delta.
+int node_encode(const NodeCodec *c, uint8_t *out, const int *job_progress, const int *job_ready,
+                const int *machine_ready, const int *path, int depth);
+// Restores the arrays the bound reads (any may be NULL); returns the depth.
+int node_decode_state(const NodeCodec *c, const uint8_t *in, int *job_progress, int *job_ready, int *machine_ready);
+// Copies the decision path; returns the depth.
+int node_decode_path(const NodeCodec *c, const uint8_t *in, int *path);
+// Writes start/end of the scheduled operations; -1 if the replay disagrees with the stored state.
+int node_rebuild_schedule(const NodeCodec *c, const uint8_t *in, Operation *table, int stride);
+
+#endif
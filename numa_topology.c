@@ -0,0 +1,131 @@
+/*
+    NUMA topology and thread placement (see numa_topology.h).
+*/
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#include <sched.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "numa_topology.h"
+
+// ================== Discovery ==================
+
+static int cpu_allowed(int cpu) {
+#ifdef __linux__
+    static cpu_set_t allowed;
+    static int loaded = 0;
+    if (!loaded) {
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return 1;
+        loaded = 1;
+    }
+    return cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed);
+#else
+    (void)cpu;
+    return 1;
+#endif
+}
+
+// Parses a sysfs cpulist ("0-3,8-11") and appends the allowed CPUs.
+static void parse_cpulist(const char *list, NumaTopology *t) {
+    const char *p = list;
+    while (*p && *p != '\n') {
+        char *end;
+        long lo = strtol(p, &end, 10), hi = lo;
+        if (end == p) break;
+        if (*end == '-') hi = strtol(end + 1, &end, 10);
+        for (long c = lo; c <= hi && t->num_cpus < NUMA_MAX_CPUS; c++)
+            if (cpu_allowed((int)c)) t->cpus[t->num_cpus++] = (int)c;
+        p = *end == ',' ? end + 1 : end;
+    }
+}
+
+static void single_node(NumaTopology *t) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    if (online < 1) online = 1;
+    t->num_nodes = 1;
+    t->num_cpus = 0;
+    for (int c = 0; c < online && t->num_cpus < NUMA_MAX_CPUS; c++)
+        if (cpu_allowed(c)) t->cpus[t->num_cpus++] = c;
+    if (t->num_cpus == 0) t->cpus[t->num_cpus++] = 0;
+    t->node_first[0] = 0;
+    t->node_first[1] = t->num_cpus;
+}
+
+// Returns the number of nodes found (1 when falling back).
+int numa_discover(NumaTopology *t) {
+    t->num_nodes = 0;
+    t->num_cpus = 0;
+    for (int node = 0; node < 256 && t->num_nodes < NUMA_MAX_NODES; node++) {   // ids may be sparse
+        char path[96], list[4096];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        FILE *fp = fopen(path, "r");
+        if (!fp) continue;
+        int ok = fgets(list, sizeof(list), fp) != NULL;
+        fclose(fp);
+        if (!ok) continue;
+
+        int first = t->num_cpus;
+        parse_cpulist(list, t);
+        if (t->num_cpus > first) {   // skip memory-only or disallowed nodes
+            t->node_first[t->num_nodes] = first;
+            t->num_nodes++;
+        }
+    }
+    if (t->num_nodes == 0) single_node(t);
+    t->node_first[t->num_nodes] = t->num_cpus;
+    return t->num_nodes;
+}
+
+// ================== Placement ==================
+
+// Node blocks sized by CPU share: node n gets workers [start(n), start(n+1)).
+static int block_start(const NumaTopology *t, int node, int workers) {
+    return (int)((long long)workers * t->node_first[node] / t->num_cpus);
+}
+
+int numa_worker_node(const NumaTopology *t, int worker, int workers) {
+    int node = 0;
+    while (node + 1 < t->num_nodes && worker >= block_start(t, node + 1, workers)) node++;
+    return node;
+}
+
+// Workers of a node take its CPUs in order, wrapping when oversubscribed.
+int numa_worker_cpu(const NumaTopology *t, int worker, int workers) {
+    int node = numa_worker_node(t, worker, workers);
+    int rank = worker - block_start(t, node, workers);
+    int size = t->node_first[node + 1] - t->node_first[node];
+    return t->cpus[t->node_first[node] + rank % size];
+}
+
+int numa_pin_thread(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0 ? 0 : -1;
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+/*
+    Stealing order for worker: the other workers of its node first (nearest
+    id first, wrapping inside the block), then the remaining workers by
+    increasing distance. order receives workers - 1 entries.
+*/
+void numa_victim_order(const NumaTopology *t, int worker, int workers, int *order) {
+    int node = numa_worker_node(t, worker, workers);
+    int lo = block_start(t, node, workers);
+    int hi = node + 1 < t->num_nodes ? block_start(t, node + 1, workers) : workers;
+    int n = 0;
+    for (int k = 1; k < hi - lo; k++) order[n++] = lo + (worker - lo + k) % (hi - lo);
+    for (int k = 1; k < workers; k++) {
+        int v = (worker + k) % workers;
+        if (v < lo || v >= hi) order[n++] = v;
+    }
+}
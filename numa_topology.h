@@ -0,0 +1,39 @@
+/*
+    NUMA topology and thread placement (Linux sysfs, no libnuma).
+
+    numa_discover() reads /sys/devices/system/node/nodeN/cpulist and keeps
+    only the CPUs this process may run on (sched_getaffinity), so cpusets
+    and taskset are respected. Without sysfs (other systems, containers
+    without /sys) everything is one node with the allowed CPUs.
+
+    Placement gives each node a contiguous block of worker ids, in
+    proportion to its CPU count: workers w and w+1 share a socket except at
+    block boundaries, so "nearest victim first" stealing stays on-node.
+
+    Memory placement relies on Linux first-touch: a page lands on the node
+    of the thread that first writes it. Data meant to be node-local is
+    therefore written first by a pinned worker, in blocks aligned to
+    NUMA_PAGE so two nodes never share a page.
+*/
+
+#ifndef NUMA_TOPOLOGY_H
+#define NUMA_TOPOLOGY_H
+
+#define NUMA_MAX_NODES 16
+#define NUMA_MAX_CPUS  1024
+#define NUMA_PAGE      4096
+
+typedef struct {
+    int num_nodes;
+    int num_cpus;
+    int node_first[NUMA_MAX_NODES + 1];   // cpus[node_first[n] .. node_first[n+1]) are on node n
+    int cpus[NUMA_MAX_CPUS];
+} NumaTopology;
+
+int  numa_discover(NumaTopology *t);
+int  numa_worker_node(const NumaTopology *t, int worker, int workers);
+int  numa_worker_cpu(const NumaTopology *t, int worker, int workers);
+int  numa_pin_thread(int cpu);   // 0 on success, -1 if unsupported or refused
+void numa_victim_order(const NumaTopology *t, int worker, int workers, int *order);
+
+#endif
@@ -0,0 +1,142 @@
+/*
+    Parallel runtime backends (see par_runtime.h).
+*/
+
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "par_runtime.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+static ParBackend backend = PAR_SEQ;
+static int num_threads = 1;
+static WorkerPool pool;
+static _Thread_local int worker_id = 0;
+static _Thread_local int worker_node = 0;
+static _Thread_local int worker_placed = 0;
+static NumaTopology topology;
+static int pinning = 0;
+
+// ================== Setup ==================
+
+// First run of a worker thread: record its node and optionally pin it.
+static void place_worker(int worker) {
+    worker_node = numa_worker_node(&topology, worker, num_threads);
+    if (pinning) numa_pin_thread(numa_worker_cpu(&topology, worker, num_threads));
+    worker_placed = 1;
+}
+
+static void pool_worker_start(void *arg, int worker) {
+    (void)arg;
+    place_worker(worker);
+}
+
+int par_init(ParBackend b, int threads) {
+    if (threads < 1) threads = 1;
+    if (threads > POOL_MAX_WORKERS) threads = POOL_MAX_WORKERS;
+#ifndef _OPENMP
+    if (b == PAR_OMP) return -1;
+#endif
+    numa_discover(&topology);
+    backend = b;
+    num_threads = b == PAR_SEQ ? 1 : threads;
+    if (b == PAR_POOL && pool_init_with_start(&pool, threads, pool_worker_start, NULL) != 0) {
+        backend = PAR_SEQ;
+        num_threads = 1;
+        return -1;
+    }
+    return 0;
+}
+
+void par_set_pinning(int enabled) { pinning = enabled; }
+
+void par_shutdown(void) {
+    if (backend == PAR_POOL) pool_destroy(&pool);
+    backend = PAR_SEQ;
+    num_threads = 1;
+}
+
+int par_parse_backend(const char *name, ParBackend *b) {
+    if (strcmp(name, "omp") == 0) *b = PAR_OMP;
+    else if (strcmp(name, "pool") == 0) *b = PAR_POOL;
+    else if (strcmp(name, "seq") == 0) *b = PAR_SEQ;
+    else return -1;
+    return 0;
+}
+
+const char *par_backend_name(ParBackend b) {
+    switch (b) {
+    case PAR_OMP:  return "omp";
+    case PAR_POOL: return "pool";
+    default:       return "seq";
+    }
+}
+
+ParBackend par_default_backend(void) {
+#ifdef _OPENMP
+    return PAR_OMP;
+#else
+    return PAR_POOL;
+#endif
+}
+
+ParBackend par_current_backend(void) { return backend; }
+int par_threads(void) { return num_threads; }
+
+// The pool's submitting thread helps with index num_workers.
+int par_worker_slots(void) { return backend == PAR_POOL ? num_threads + 1 : num_threads; }
+int par_worker_id(void) { return worker_id; }
+int par_worker_node(void) { return worker_node; }
+int par_num_nodes(void) { return topology.num_nodes; }
+
+double par_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// ================== Parallel loop ==================
+
+typedef struct {
+    ParRangeFn fn;
+    void *ctx;
+} RangeCall;
+
+static void pool_range(void *ctx, int begin, int end, int worker) {
+    RangeCall *call = ctx;
+    int caller = worker_id;   // a worker running a nested loop's chunk inline
+    worker_id = worker;
+    call->fn(call->ctx, begin, end);
+    worker_id = caller;
+}
+
+void par_for(int n, int chunk, ParRangeFn fn, void *ctx) {
+    if (n <= 0) return;
+    if (chunk < 1) chunk = 1;
+
+    if (backend == PAR_POOL) {
+        RangeCall call = { fn, ctx };
+        pool_parallel_for(&pool, n, chunk, pool_range, &call);
+        return;
+    }
+#ifdef _OPENMP
+    if (backend == PAR_OMP) {
+        int chunks = (n + chunk - 1) / chunk;
+        #pragma omp parallel num_threads(num_threads)
+        {
+            worker_id = omp_get_thread_num();
+            if (!worker_placed) place_worker(worker_id);
+            #pragma omp for schedule(dynamic, 1)
+            for (int c = 0; c < chunks; c++) {
+                int begin = c * chunk;
+                fn(ctx, begin, begin + chunk < n ? begin + chunk : n);
+            }
+        }
+        worker_id = 0;
+        return;
+    }
+#endif
+    fn(ctx, 0, n);
+}
@@ -0,0 +1,77 @@
+/*
+    Parallel runtime with interchangeable backends.
+
+    Solvers write their parallel parts once against this interface and pick
+    the implementation at run time (--backend=NAME):
+    - omp:  OpenMP parallel for / dynamic schedule (only when compiled with
+            -fopenmp; the others build without libomp)
+    - pool: the persistent pthread worker pool of worker_pool.c
+    - seq:  everything inline on the calling thread (reference / profiling)
+
+    Primitives:
+    - par_for():    [0, n) in chunks of `chunk`, dynamically balanced
+    - ParIncumbent: atomic best value shared by all workers (minimisation)
+
+    NUMA (numa_topology.h): par_init() reads the topology and assigns each
+    worker a node (contiguous worker blocks per node); par_worker_node()
+    tells data replicated per node which copy to use. With
+    par_set_pinning(1) before par_init() every worker is also pinned to its
+    CPU the first time it runs, so per-worker data it first touches stays
+    on its node.
+
+    par_worker_id() is the calling worker's index in [0, par_worker_slots()),
+    valid inside par_for() bodies; size per-worker arrays with
+    par_worker_slots() (at most PAR_MAX_SLOTS).
+*/
+
+#ifndef PAR_RUNTIME_H
+#define PAR_RUNTIME_H
+
+#include <stdatomic.h>
+#include "worker_pool.h"
+#include "numa_topology.h"
+
+#define PAR_MAX_SLOTS (POOL_MAX_WORKERS + 1)
+
+typedef enum { PAR_SEQ, PAR_OMP, PAR_POOL } ParBackend;
+
+typedef void (*ParRangeFn)(void *ctx, int begin, int end);
+
+typedef struct {
+    _Alignas(64) atomic_int value;
+} ParIncumbent;
+
+int  par_init(ParBackend backend, int threads);   // -1 if the backend is not available
+void par_set_pinning(int enabled);
+void par_shutdown(void);
+int  par_parse_backend(const char *name, ParBackend *backend);
+const char *par_backend_name(ParBackend backend);
+ParBackend par_default_backend(void);
+ParBackend par_current_backend(void);
+int  par_threads(void);
+int  par_worker_slots(void);
+int  par_worker_id(void);
+int  par_worker_node(void);
+int  par_num_nodes(void);
+double par_time(void);    // wall-clock seconds
+
+void par_for(int n, int chunk, ParRangeFn fn, void *ctx);
+
+static inline void par_incumbent_init(ParIncumbent *inc, int value) {
+    atomic_store(&inc->value, value);
+}
+
+static inline int par_incumbent_get(ParIncumbent *inc) {
+    return atomic_load_explicit(&inc->value, memory_order_relaxed);
+}
+
+// Lowers the incumbent to value if that is an improvement; 1 if it was.
+static inline int par_incumbent_improve(ParIncumbent *inc, int value) {
+    int current = atomic_load_explicit(&inc->value, memory_order_relaxed);
+    while (value < current) {
+        if (atomic_compare_exchange_weak(&inc->value, &current, value)) return 1;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,400 @@
+/*
+    Disjunctive-resource propagation with trailing (see propagation.h).
+
+    The filtering algorithms follow Vilim, "O(n log n) filtering algorithms
+    for unary resource constraint" (CPAIOR 2004) and Vilim, Bartak, Cepek,
+    "Extension of O(n log n) filtering algorithms for the unary resource
+    constraint to optional activities" (Constraints 2005). They work on a
+    local copy (est, lct, p) of the unscheduled operations of one machine
+    and only ever tighten: the lct-side rules run the est-side code on the
+    mirrored windows [-lct, -est].
+*/
+
+#include <string.h>
+#include <limits.h>
+#include "propagation.h"
+
+#define NEG_INF (INT_MIN / 4)
+#define MAX2(a, b) ((a) > (b) ? (a) : (b))
+#define MIN2(a, b) ((a) < (b) ? (a) : (b))
+
+// Variable layout of the trail: est, lct, scheduled, horizon.
+#define VAR_EST(k)   (k)
+#define VAR_LCT(k)   (PROP_MAX_OPS + (k))
+#define VAR_SCHED(k) (2 * PROP_MAX_OPS + (k))
+#define VAR_HORIZON  (3 * PROP_MAX_OPS)
+
+// ================== Trail ==================
+
+static int *var_ref(PropState *s, int var) {
+    if (var < PROP_MAX_OPS) return &s->est[var];
+    if (var < 2 * PROP_MAX_OPS) return &s->lct[var - PROP_MAX_OPS];
+    if (var < 3 * PROP_MAX_OPS) return &s->scheduled[var - 2 * PROP_MAX_OPS];
+    return &s->horizon;
+}
+
+static void assign(PropState *s, int var, int value) {
+    int *ref = var_ref(s, var);
+    if (s->var_stamp[var] != s->stamp) {
+        s->var_stamp[var] = s->stamp;
+        s->trail[s->trail_size].var = var;
+        s->trail[s->trail_size].old = *ref;
+        s->trail_size++;
+    }
+    *ref = value;
+}
+
+static void raise_est(PropState *s, int k, int value) {
+    if (value <= s->est[k]) return;
+    assign(s, VAR_EST(k), value);
+    s->dirty[s->machine[k]] = 1;
+    s->est_updates++;
+}
+
+static void lower_lct(PropState *s, int k, int value) {
+    if (value >= s->lct[k]) return;
+    assign(s, VAR_LCT(k), value);
+    s->dirty[s->machine[k]] = 1;
+    s->lct_updates++;
+}
+
+int prop_push(PropState *s) {
+    s->stamp++;
+    return s->trail_size;
+}
+
+void prop_pop(PropState *s, int mark) {
+    while (s->trail_size > mark) {
+        s->trail_size--;
+        *var_ref(s, s->trail[s->trail_size].var) = s->trail[s->trail_size].old;
+    }
+    s->stamp++;
+}
+
+// ================== Theta-Lambda tree ==================
+
+static void tree_clear(ThetaTree *t, int n) {
+    t->leaves = 1;
+    while (t->leaves < n) t->leaves <<= 1;
+    for (int v = 1; v < 2 * t->leaves; v++) {
+        t->sum[v] = t->sum_bar[v] = 0;
+        t->ect[v] = t->ect_bar[v] = NEG_INF;
+        t->resp_sum[v] = t->resp_ect[v] = -1;
+    }
+}
+
+static void tree_combine(ThetaTree *t, int v) {
+    int l = 2 * v, r = 2 * v + 1;
+    t->sum[v] = t->sum[l] + t->sum[r];
+    t->ect[v] = MAX2(t->ect[r], t->ect[l] + t->sum[r]);
+
+    if (t->sum_bar[l] + t->sum[r] >= t->sum[l] + t->sum_bar[r]) {
+        t->sum_bar[v] = t->sum_bar[l] + t->sum[r];
+        t->resp_sum[v] = t->resp_sum[l];
+    } else {
+        t->sum_bar[v] = t->sum[l] + t->sum_bar[r];
+        t->resp_sum[v] = t->resp_sum[r];
+    }
+
+    int through_right = t->ect_bar[r];
+    int left_then_right = t->ect[l] + t->sum_bar[r];
+    int gray_left = t->ect_bar[l] + t->sum[r];
+    if (through_right >= left_then_right && through_right >= gray_left) {
+        t->ect_bar[v] = through_right;
+        t->resp_ect[v] = t->resp_ect[r];
+    } else if (left_then_right >= gray_left) {
+        t->ect_bar[v] = left_then_right;
+        t->resp_ect[v] = t->resp_sum[r];
+    } else {
+        t->ect_bar[v] = gray_left;
+        t->resp_ect[v] = t->resp_ect[l];
+    }
+}
+
+// Leaf states: white (in Theta), gray (in Lambda, responsible id), empty.
+static void tree_set(ThetaTree *t, int leaf, int est, int p, int gray_id, int present) {
+    int v = t->leaves + leaf;
+    if (!present) {
+        t->sum[v] = t->sum_bar[v] = 0;
+        t->ect[v] = t->ect_bar[v] = NEG_INF;
+        t->resp_sum[v] = t->resp_ect[v] = -1;
+    } else if (gray_id < 0) {
+        t->sum[v] = t->sum_bar[v] = p;
+        t->ect[v] = t->ect_bar[v] = est + p;
+        t->resp_sum[v] = t->resp_ect[v] = -1;
+    } else {
+        t->sum[v] = 0;
+        t->ect[v] = NEG_INF;
+        t->sum_bar[v] = p;
+        t->ect_bar[v] = est + p;
+        t->resp_sum[v] = t->resp_ect[v] = gray_id;
+    }
+    for (v >>= 1; v >= 1; v >>= 1) tree_combine(t, v);
+}
+
+// ================== Machine filtering ==================
+
+// Insertion sort of 0..n-1 by key (n is at most one machine's operations).
+// Arrays are non-const: gcc 12 flags const views of partly filled arrays.
+static void sort_by(int n, int *key, int *order) {
+    for (int a = 0; a < n; a++) {
+        int x = order[a] = a, b = a;
+        while (b > 0 && key[order[b - 1]] > key[x]) { order[b] = order[b - 1]; b--; }
+        order[b] = x;
+    }
+}
+
+/*
+    Overload checking and edge-finding: with Theta the operations whose lct
+    is at most lct_j, any gray operation i that makes ECT(Theta + i) exceed
+    lct_j must come after all of Theta, so est_i >= ECT(Theta).
+*/
+static int edge_finding(ThetaTree *t, int n, int *est, int *lct, int *p, int *new_est) {
+    int by_est[PROP_MAX_PER_MACHINE], rank[PROP_MAX_PER_MACHINE], by_lct[PROP_MAX_PER_MACHINE], neg[PROP_MAX_PER_MACHINE];
+    sort_by(n, est, by_est);
+    for (int a = 0; a < n; a++) { rank[by_est[a]] = a; neg[a] = -lct[a]; }
+    sort_by(n, neg, by_lct);   // decreasing lct
+
+    tree_clear(t, n);
+    for (int a = 0; a < n; a++) tree_set(t, rank[a], est[a], p[a], -1, 1);
+
+    for (int q = 0; q < n - 1; q++) {
+        int j = by_lct[q];
+        if (t->ect[1] > lct[j]) return -1;
+        tree_set(t, rank[j], est[j], p[j], j, 1);
+        int next = by_lct[q + 1];
+        while (t->ect_bar[1] > lct[next] && t->resp_ect[1] >= 0) {
+            int i = t->resp_ect[1];
+            new_est[i] = MAX2(new_est[i], t->ect[1]);
+            tree_set(t, rank[i], est[i], p[i], -1, 0);
+        }
+    }
+    return t->ect[1] > lct[by_lct[n - 1]] ? -1 : 0;
+}
+
+/*
+    Detectable precedences: j << i when est_i + p_i > lct_j - p_j. Taking i
+    by increasing ect, those j enter Theta by increasing lst, and
+    est_i >= ECT(Theta \ {i}).
+*/
+static void detectable_precedences(ThetaTree *t, int n, int *est, int *lct, int *p, int *new_est) {
+    int by_est[PROP_MAX_PER_MACHINE], rank[PROP_MAX_PER_MACHINE], by_ect[PROP_MAX_PER_MACHINE], by_lst[PROP_MAX_PER_MACHINE];
+    int ect[PROP_MAX_PER_MACHINE], lst[PROP_MAX_PER_MACHINE];
+    unsigned char in_theta[PROP_MAX_PER_MACHINE] = {0};
+    for (int a = 0; a < n; a++) { ect[a] = est[a] + p[a]; lst[a] = lct[a] - p[a]; }
+    sort_by(n, est, by_est);
+    for (int a = 0; a < n; a++) rank[by_est[a]] = a;
+    sort_by(n, ect, by_ect);
+    sort_by(n, lst, by_lst);
+
+    tree_clear(t, n);
+    int q = 0;
+    for (int a = 0; a < n; a++) {
+        int i = by_ect[a];
+        while (q < n && ect[i] > lst[by_lst[q]]) {
+            int j = by_lst[q++];
+            tree_set(t, rank[j], est[j], p[j], -1, 1);
+            in_theta[j] = 1;
+        }
+        if (in_theta[i]) tree_set(t, rank[i], est[i], p[i], -1, 0);
+        new_est[i] = MAX2(new_est[i], t->ect[1]);
+        if (in_theta[i]) tree_set(t, rank[i], est[i], p[i], -1, 1);
+    }
+}
+
+/*
+    Not-last: if ECT(Theta \ {i}) > lst_i, with Theta the operations whose
+    lst is below lct_i, then i cannot be last among them and must end by the
+    largest lst in Theta (the last one inserted).
+*/
+static void not_last(ThetaTree *t, int n, int *est, int *lct, int *p, int *new_lct) {
+    int by_est[PROP_MAX_PER_MACHINE], rank[PROP_MAX_PER_MACHINE], by_lct[PROP_MAX_PER_MACHINE], by_lst[PROP_MAX_PER_MACHINE];
+    int lst[PROP_MAX_PER_MACHINE];
+    unsigned char in_theta[PROP_MAX_PER_MACHINE] = {0};
+    for (int a = 0; a < n; a++) lst[a] = lct[a] - p[a];
+    sort_by(n, est, by_est);
+    for (int a = 0; a < n; a++) rank[by_est[a]] = a;
+    sort_by(n, lct, by_lct);
+    sort_by(n, lst, by_lst);
+
+    tree_clear(t, n);
+    int q = 0, last = -1;
+    for (int a = 0; a < n; a++) {
+        int i = by_lct[a];
+        while (q < n && lct[i] > lst[by_lst[q]]) {
+            last = by_lst[q++];
+            tree_set(t, rank[last], est[last], p[last], -1, 1);
+            in_theta[last] = 1;
+        }
+        if (in_theta[i]) tree_set(t, rank[i], est[i], p[i], -1, 0);
+        if (last >= 0 && t->ect[1] > lst[i]) new_lct[i] = MIN2(new_lct[i], lst[last]);
+        if (in_theta[i]) tree_set(t, rank[i], est[i], p[i], -1, 1);
+    }
+}
+
+/*
+    All rules on the unscheduled operations of machine m, each computed from
+    the same windows and combined by max/min. The est-side rules run on the
+    mirrored windows to give the lct-side ones (and not-last gives
+    not-first).
+*/
+static int propagate_machine(PropState *s, int m) {
+    int ids[PROP_MAX_PER_MACHINE], est[PROP_MAX_PER_MACHINE], lct[PROP_MAX_PER_MACHINE], p[PROP_MAX_PER_MACHINE];
+    int mest[PROP_MAX_PER_MACHINE], mlct[PROP_MAX_PER_MACHINE];
+    int new_est[PROP_MAX_PER_MACHINE], new_lct[PROP_MAX_PER_MACHINE];
+    int mnew_est[PROP_MAX_PER_MACHINE], mnew_lct[PROP_MAX_PER_MACHINE];
+    int n = 0;
+    for (int a = 0; a < s->mach_count[m]; a++) {
+        int k = s->mach_ops[m][a];
+        if (s->scheduled[k]) continue;
+        ids[n] = k;
+        est[n] = s->est[k];
+        lct[n] = s->lct[k];
+        p[n] = s->dur[k];
+        mest[n] = -lct[n];
+        mlct[n] = -est[n];
+        new_est[n] = est[n];
+        new_lct[n] = lct[n];
+        mnew_est[n] = mest[n];
+        mnew_lct[n] = mlct[n];
+        n++;
+    }
+    if (n < 2) return 0;
+
+    if (edge_finding(&s->tree, n, est, lct, p, new_est) < 0) return -1;
+    if (edge_finding(&s->tree, n, mest, mlct, p, mnew_est) < 0) return -1;
+    detectable_precedences(&s->tree, n, est, lct, p, new_est);
+    detectable_precedences(&s->tree, n, mest, mlct, p, mnew_est);
+    not_last(&s->tree, n, est, lct, p, new_lct);
+    not_last(&s->tree, n, mest, mlct, p, mnew_lct);   // not-first
+
+    for (int a = 0; a < n; a++) {
+        int k = ids[a];
+        raise_est(s, k, MAX2(new_est[a], -mnew_lct[a]));
+        lower_lct(s, k, MIN2(new_lct[a], -mnew_est[a]));
+        if (s->est[k] + s->dur[k] > s->lct[k]) return -1;
+    }
+    return 0;
+}
+
+// ================== Fixpoint ==================
+
+static int propagate_jobs(PropState *s) {
+    for (int j = 0; j < s->num_jobs; j++) {
+        int first = j * s->num_ops, last = first + s->num_ops - 1;
+        lower_lct(s, last, s->horizon);
+        for (int k = first + 1; k <= last; k++)
+            raise_est(s, k, s->est[k - 1] + s->dur[k - 1]);
+        for (int k = last - 1; k >= first; k--)
+            lower_lct(s, k, s->lct[k + 1] - s->dur[k + 1]);
+        for (int k = first; k <= last; k++)
+            if (s->est[k] + s->dur[k] > s->lct[k]) return -1;
+    }
+    return 0;
+}
+
+static int propagate(PropState *s) {
+    s->calls++;
+    for (;;) {
+        int any = 0;
+        if (propagate_jobs(s) < 0) break;
+        int m;
+        for (m = 0; m < s->num_machines; m++) {
+            if (!s->dirty[m]) continue;
+            s->dirty[m] = 0;
+            any = 1;
+            if (propagate_machine(s, m) < 0) break;
+        }
+        if (m < s->num_machines) break;
+        if (!any) return 0;
+    }
+    s->failures++;
+    memset(s->dirty, 0, sizeof(s->dirty));
+    return -1;
+}
+
+// ================== API ==================
+
+int prop_init(PropState *s, ScheduleView v, int horizon) {
+    if (v.num_jobs * v.num_ops > PROP_MAX_OPS || v.num_machines > PROP_MAX_MACHINES) return -1;
+    s->num_jobs = v.num_jobs;
+    s->num_ops = v.num_ops;
+    s->num_machines = v.num_machines;
+    s->num_nodes = v.num_jobs * v.num_ops;
+    memset(s->mach_count, 0, sizeof(s->mach_count));
+
+    for (int j = 0; j < v.num_jobs; j++) {
+        int work = 0;
+        for (int i = v.num_ops - 1; i >= 0; i--) {
+            int k = j * v.num_ops + i, m = VIEW_OP(v, j, i).machine;
+            if (m < 0 || m >= v.num_machines || s->mach_count[m] == PROP_MAX_PER_MACHINE) return -1;
+            s->dur[k] = VIEW_OP(v, j, i).duration;
+            s->machine[k] = m;
+            s->tail_work[k] = work;
+            work += s->dur[k];
+        }
+        for (int i = 0; i < v.num_ops; i++) {
+            int k = j * v.num_ops + i;
+            s->mach_ops[s->machine[k]][s->mach_count[s->machine[k]]++] = k;
+        }
+    }
+
+    s->horizon = horizon;
+    for (int k = 0; k < s->num_nodes; k++) {
+        s->est[k] = 0;
+        s->lct[k] = horizon - s->tail_work[k];
+        s->scheduled[k] = 0;
+    }
+    s->stamp = 1;
+    s->trail_size = 0;
+    memset(s->var_stamp, 0, sizeof(s->var_stamp));
+    memset(s->dirty, 1, sizeof(s->dirty));
+    return propagate(s) < 0 ? -1 : 0;
+}
+
+int prop_set_horizon(PropState *s, int horizon) {
+    if (horizon >= s->horizon) return 0;
+    assign(s, VAR_HORIZON, horizon);
+    return propagate(s);
+}
+
+int prop_schedule(PropState *s, int job, int op, int start) {
+    int k = job * s->num_ops + op, m = s->machine[k], end = start + s->dur[k];
+    assign(s, VAR_SCHED(k), 1);
+    raise_est(s, k, start);
+    lower_lct(s, k, end);
+    if (s->est[k] != start || s->lct[k] != end) {
+        s->failures++;
+        memset(s->dirty, 0, sizeof(s->dirty));
+        return -1;
+    }
+    for (int a = 0; a < s->mach_count[m]; a++) {
+        int o = s->mach_ops[m][a];
+        if (!s->scheduled[o]) raise_est(s, o, end);
+    }
+    return propagate(s);
+}
+
+/*
+    Job bound (every window is already consistent with its job chain) and
+    machine bound: the unscheduled operations of a machine start no earlier
+    than their smallest est and are followed by at least the smallest job
+    tail among them.
+*/
+int prop_lower_bound(const PropState *s) {
+    int bound = 0;
+    for (int k = 0; k < s->num_nodes; k++)
+        bound = MAX2(bound, s->est[k] + s->dur[k] + s->tail_work[k]);
+    for (int m = 0; m < s->num_machines; m++) {
+        int first = INT_MAX, tail = INT_MAX, work = 0;
+        for (int a = 0; a < s->mach_count[m]; a++) {
+            int k = s->mach_ops[m][a];
+            if (s->scheduled[k]) continue;
+            first = MIN2(first, s->est[k]);
+            tail = MIN2(tail, s->tail_work[k]);
+            work += s->dur[k];
+        }
+        if (first != INT_MAX) bound = MAX2(bound, first + work + tail);
+    }
+    return bound;
+}
@@ -0,0 +1,85 @@
+/*
+    Disjunctive-resource constraint propagation for the exact job-shop solvers.
+
+    Every operation k = j * num_ops + i has a time window [est[k], lct[k]]
+    (earliest start, latest completion) under the constraint
+    makespan <= horizon. Propagation shrinks the windows to a fixpoint of
+    - job precedences: est/lct pushed along every job chain
+    - per machine, on its unscheduled operations, with Vilim's Theta-trees
+      (O(n log n) each, both directions by mirroring the time axis):
+        overload checking + edge-finding (Theta-Lambda tree)
+        detectable precedences
+        not-first / not-last
+    and reports a failure when some window becomes empty: no schedule of
+    the current subtree can reach makespan <= horizon.
+
+    The branch-and-bound schedules by appending: prop_schedule() fixes an
+    operation at its start and puts it before every unscheduled operation of
+    its machine. An operation whose est is above the append start cannot be
+    the next one on its machine (edge-finding, detectable precedences or
+    not-first put another operation before it), so the branch is pruned.
+
+    State changes are trailed: prop_push() opens a decision level and
+    prop_pop() restores every window changed since, so backtracking costs
+    only what the subtree changed. Each variable is trailed at most once per
+    level (stamps), which bounds the trail by levels x variables.
+*/
+
+#ifndef PROPAGATION_H
+#define PROPAGATION_H
+
+#include "jobshop.h"
+
+#define PROP_MAX_OPS         256   // 15x15 instances and below
+#define PROP_MAX_MACHINES    32
+#define PROP_MAX_PER_MACHINE 64    // Theta-tree leaves
+#define PROP_NUM_VARS        (3 * PROP_MAX_OPS + 1)   // est, lct, scheduled, horizon
+#define PROP_MAX_TRAIL       (PROP_NUM_VARS * (PROP_MAX_OPS + 2))
+
+typedef struct {
+    int var;
+    int old;
+} PropTrailEntry;
+
+// Theta-Lambda tree over the operations of one machine sorted by est.
+typedef struct {
+    int leaves;
+    int sum[2 * PROP_MAX_PER_MACHINE], ect[2 * PROP_MAX_PER_MACHINE];
+    int sum_bar[2 * PROP_MAX_PER_MACHINE], ect_bar[2 * PROP_MAX_PER_MACHINE];
+    int resp_sum[2 * PROP_MAX_PER_MACHINE], resp_ect[2 * PROP_MAX_PER_MACHINE];
+} ThetaTree;
+
+// Large (about 1.6 MB, mostly trail): declare instances static, one per worker.
+typedef struct {
+    // instance
+    int num_jobs, num_ops, num_machines, num_nodes;
+    int dur[PROP_MAX_OPS], machine[PROP_MAX_OPS];
+    int tail_work[PROP_MAX_OPS];       // durations after k in its job
+    int mach_count[PROP_MAX_MACHINES];
+    int mach_ops[PROP_MAX_MACHINES][PROP_MAX_PER_MACHINE];
+    // trailed state
+    int horizon;
+    int est[PROP_MAX_OPS], lct[PROP_MAX_OPS];
+    int scheduled[PROP_MAX_OPS];
+    unsigned long long stamp;
+    unsigned long long var_stamp[PROP_NUM_VARS];
+    int trail_size;
+    PropTrailEntry trail[PROP_MAX_TRAIL];
+    // scratch
+    unsigned char dirty[PROP_MAX_MACHINES];
+    ThetaTree tree;
+    // statistics (not trailed, not reset by prop_init)
+    unsigned long long calls, failures, est_updates, lct_updates;
+} PropState;
+
+int  prop_init(PropState *s, ScheduleView instance, int horizon);   // -1 if larger than the limits
+int  prop_push(PropState *s);                                      // returns the mark for prop_pop
+void prop_pop(PropState *s, int mark);
+int  prop_set_horizon(PropState *s, int horizon);                  // -1: no schedule within it
+int  prop_schedule(PropState *s, int job, int op, int start);      // -1: subtree infeasible
+int  prop_lower_bound(const PropState *s);
+
+static inline int prop_est(const PropState *s, int job, int op) { return s->est[job * s->num_ops + op]; }
+static inline int prop_lct(const PropState *s, int job, int op) { return s->lct[job * s->num_ops + op]; }
+
+#endif
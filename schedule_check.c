@@ -0,0 +1,122 @@
+/*
+    Schedule validator and critical-path analyzer (see schedule_check.h).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "schedule_check.h"
+
+static int fail(ScheduleCheck *check, ScheduleError error, int j, int i, int oj, int oi) {
+    check->error = error;
+    check->job = j;
+    check->op = i;
+    check->other_job = oj;
+    check->other_op = oi;
+    return error;
+}
+
+const char *schedule_error_name(ScheduleError error) {
+    switch (error) {
+        case SCHEDULE_OK:              return "ok";
+        case SCHEDULE_BAD_INSTANCE:    return "machine/duration differs from instance";
+        case SCHEDULE_BAD_TIMES:       return "end != start + duration";
+        case SCHEDULE_PRECEDENCE:      return "job precedence violated";
+        case SCHEDULE_MACHINE_OVERLAP: return "machine overlap";
+        case SCHEDULE_TOO_LARGE:       return "schedule too large";
+    }
+    return "unknown";
+}
+
+// Returns SCHEDULE_OK (0) or the first violation found; details go to check.
+int validate_schedule(ScheduleView v, const ScheduleView *instance, MachineTimeline *tl, ScheduleCheck *check) {
+    return analyze_schedule(v, instance, tl, check, NULL);
+}
+
+/*
+    Validation plus, when cp is not NULL, critical path extraction.
+    The path is followed backwards from an operation that ends at the makespan:
+    the predecessor is the machine predecessor if it ends exactly at our start,
+    otherwise the job predecessor if it does. Preferring the machine keeps the
+    blocks as long as possible.
+*/
+int analyze_schedule(ScheduleView v, const ScheduleView *instance, MachineTimeline *tl,
+                     ScheduleCheck *check, CriticalPath *cp) {
+    fail(check, SCHEDULE_OK, -1, -1, -1, -1);
+    check->makespan = 0;
+
+    int last_j = -1, last_i = -1;
+    for (int j = 0; j < v.num_jobs; j++) {
+        int job_ready = 0;
+        for (int i = 0; i < v.num_ops; i++) {
+            const Operation *o = &VIEW_OP(v, j, i);
+            if (instance && (o->machine != VIEW_OP(*instance, j, i).machine ||
+                             o->duration != VIEW_OP(*instance, j, i).duration))
+                return fail(check, SCHEDULE_BAD_INSTANCE, j, i, -1, -1);
+            if (o->start < 0 || o->end != o->start + o->duration ||
+                o->machine < 0 || o->machine >= v.num_machines)
+                return fail(check, SCHEDULE_BAD_TIMES, j, i, -1, -1);
+            if (o->start < job_ready)
+                return fail(check, SCHEDULE_PRECEDENCE, j, i, j, i - 1);
+            job_ready = o->end;
+            if (o->end > check->makespan) { check->makespan = o->end; last_j = j; last_i = i; }
+        }
+    }
+
+    if (build_timeline(tl, v) != 0) return fail(check, SCHEDULE_TOO_LARGE, -1, -1, -1, -1);
+    for (int m = 0; m < tl->num_machines; m++) {
+        for (int e = tl->machine_begin[m] + 1; e < tl->machine_begin[m + 1]; e++) {
+            const TimelineEntry *prev = &tl->entries[e - 1], *cur = &tl->entries[e];
+            if (cur->start < prev->end)
+                return fail(check, SCHEDULE_MACHINE_OVERLAP, cur->job, cur->op, prev->job, prev->op);
+        }
+    }
+    if (!cp || last_j < 0) return SCHEDULE_OK;
+
+    for (int e = 0; e < tl->count; e++)
+        cp->position[tl->entries[e].job * v.num_ops + tl->entries[e].op] = e;
+
+    // Walk back from the last operation; collected in reverse, then flipped.
+    int n = 0, j = last_j, i = last_i;
+    for (;;) {
+        cp->path[n++] = (OpRef){ j, i };
+        const Operation *o = &VIEW_OP(v, j, i);
+        int m = o->machine;
+        int e = cp->position[j * v.num_ops + i];
+        if (e > tl->machine_begin[m] && tl->entries[e - 1].end == o->start) {
+            j = tl->entries[e - 1].job;
+            i = tl->entries[e - 1].op;
+        } else if (i > 0 && VIEW_OP(v, j, i - 1).end == o->start) {
+            i--;
+        } else {
+            break;   // starts at 0 (or after idle time in a non semi-active schedule)
+        }
+    }
+    for (int a = 0, b = n - 1; a < b; a++, b--) {
+        OpRef tmp = cp->path[a];
+        cp->path[a] = cp->path[b];
+        cp->path[b] = tmp;
+    }
+    cp->length = n;
+
+    cp->num_blocks = 0;
+    for (int k = 0; k < n; k++) {
+        int m = VIEW_OP(v, cp->path[k].job, cp->path[k].op).machine;
+        if (k == 0 || m != VIEW_OP(v, cp->path[k - 1].job, cp->path[k - 1].op).machine)
+            cp->block_begin[cp->num_blocks++] = k;
+    }
+    cp->block_begin[cp->num_blocks] = n;
+    return SCHEDULE_OK;
+}
+
+// Debug assertion: prints the first violation and aborts.
+void assert_valid_schedule(ScheduleView v, const ScheduleView *instance, const char *where) {
+    static MachineTimeline tl;
+    ScheduleCheck check;
+    if (validate_schedule(v, instance, &tl, &check) != SCHEDULE_OK) {
+        fprintf(stderr, "[CHECK] %s: invalid schedule (%s) at job %d op %d",
+                where, schedule_error_name(check.error), check.job, check.op);
+        if (check.other_job >= 0) fprintf(stderr, " vs job %d op %d", check.other_job, check.other_op);
+        fprintf(stderr, "\n");
+        abort();
+    }
+}
@@ -0,0 +1,60 @@
+/*
+    Schedule validator and critical-path analyzer.
+
+    validate_schedule() checks any Operation schedule in O(N) (the per-machine
+    order comes from the radix-sorted MachineTimeline):
+    - durations/machines match the instance (when one is given) and end = start + duration
+    - precedence: each operation starts after its job predecessor ends
+    - capacity: consecutive operations on a machine do not overlap
+
+    On a valid schedule the same pass can extract a critical path (a chain of
+    operations with no idle time that ends at the makespan) and split it into
+    critical blocks: maximal runs of consecutive path operations on one machine.
+    Swapping the first or last two operations of a block is the classic
+    neighbourhood move for local search.
+*/
+
+#ifndef SCHEDULE_CHECK_H
+#define SCHEDULE_CHECK_H
+
+#include "jobshop.h"
+#include "schedule_output.h"
+
+typedef enum {
+    SCHEDULE_OK = 0,
+    SCHEDULE_BAD_INSTANCE,      // machine or duration differs from the instance
+    SCHEDULE_BAD_TIMES,         // negative start or end != start + duration
+    SCHEDULE_PRECEDENCE,        // starts before its job predecessor ends
+    SCHEDULE_MACHINE_OVERLAP,   // overlaps another operation on its machine
+    SCHEDULE_TOO_LARGE
+} ScheduleError;
+
+typedef struct {
+    ScheduleError error;
+    int job, op;                // offending operation
+    int other_job, other_op;    // predecessor or overlapping operation, -1 if none
+    int makespan;
+} ScheduleCheck;
+
+typedef struct {
+    int job;
+    int op;
+} OpRef;
+
+// Large: declare instances static.
+typedef struct {
+    int length;                              // operations on the path, first to last
+    OpRef path[JSS_MAX_OPERATIONS];
+    int num_blocks;
+    int block_begin[JSS_MAX_OPERATIONS + 1]; // block b is path[block_begin[b] .. block_begin[b+1])
+    int position[JSS_MAX_OPERATIONS];        // timeline index of operation j * num_ops + i
+} CriticalPath;
+
+int  validate_schedule(ScheduleView v, const ScheduleView *instance, MachineTimeline *tl, ScheduleCheck *check);
+int  analyze_schedule(ScheduleView v, const ScheduleView *instance, MachineTimeline *tl,
+                      ScheduleCheck *check, CriticalPath *cp);
+const char *schedule_error_name(ScheduleError error);
+// Uses one static timeline: call it from one thread at a time (the solvers' main thread)
+void assert_valid_schedule(ScheduleView v, const ScheduleView *instance, const char *where);
+
+#endif
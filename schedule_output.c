@@ -0,0 +1,256 @@
+/*
+    Schedule output layer (see schedule_output.h).
+*/
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "schedule_output.h"
+
+// ================== Timeline ==================
+
+// One stable counting-sort pass of src into dst on a 16-bit digit of the key.
+static void radix_pass(MachineTimeline *tl, const TimelineEntry *src, TimelineEntry *dst,
+                       int n, int by_machine, int shift, const int *machine_of) {
+    int *count = tl->radix_count;
+    memset(count, 0, sizeof(tl->radix_count));
+    for (int k = 0; k < n; k++) {
+        unsigned key = by_machine ? (unsigned)machine_of[k] : ((unsigned)src[k].start >> shift) & 0xFFFFu;
+        count[key]++;
+    }
+    int sum = 0;
+    for (int key = 0; key < (1 << 16); key++) {
+        int c = count[key];
+        count[key] = sum;
+        sum += c;
+    }
+    for (int k = 0; k < n; k++) {
+        unsigned key = by_machine ? (unsigned)machine_of[k] : ((unsigned)src[k].start >> shift) & 0xFFFFu;
+        dst[count[key]++] = src[k];
+    }
+}
+
+/*
+    Groups the operations per machine, each group sorted by start time.
+    Sorting by start first and then stably by machine gives the (machine, start)
+    order without any comparison sort. Returns -1 if the schedule does not fit.
+*/
+int build_timeline(MachineTimeline *tl, ScheduleView v) {
+    int n = v.num_jobs * v.num_ops;
+    if (n > JSS_MAX_OPERATIONS || v.num_machines > JSS_MAX_MACHINES) return -1;
+
+    tl->num_machines = v.num_machines;
+    tl->count = n;
+    tl->makespan = 0;
+
+    int k = 0;
+    for (int j = 0; j < v.num_jobs; j++) {
+        for (int i = 0; i < v.num_ops; i++) {
+            const Operation *o = &VIEW_OP(v, j, i);
+            tl->scratch[k] = (TimelineEntry){ j, i, o->start, o->end };
+            if (o->end > tl->makespan) tl->makespan = o->end;
+            k++;
+        }
+    }
+
+    // Start times by 16-bit digits; the high digit is skipped for short horizons.
+    radix_pass(tl, tl->scratch, tl->entries, n, 0, 0, NULL);
+    const TimelineEntry *by_start = tl->entries;
+    if (tl->makespan >= (1 << 16)) {
+        radix_pass(tl, tl->entries, tl->scratch, n, 0, 16, NULL);
+        by_start = tl->scratch;
+    }
+
+    // Final stable pass by machine; machine ids are looked up from the view.
+    int *machine_of = tl->machine_of;
+    for (int e = 0; e < n; e++)
+        machine_of[e] = VIEW_OP(v, by_start[e].job, by_start[e].op).machine;
+    if (by_start == tl->entries) {
+        memcpy(tl->scratch, tl->entries, (size_t)n * sizeof(TimelineEntry));
+        by_start = tl->scratch;
+    }
+    radix_pass(tl, by_start, tl->entries, n, 1, 0, machine_of);
+
+    for (int m = 0; m <= v.num_machines; m++) tl->machine_begin[m] = 0;
+    for (int e = 0; e < n; e++) tl->machine_begin[machine_of[e] + 1]++;
+    for (int m = 0; m < v.num_machines; m++) tl->machine_begin[m + 1] += tl->machine_begin[m];
+    return 0;
+}
+
+// ================== Buffered writer ==================
+void writer_init(OutputWriter *w, FILE *fp) {
+    w->fp = fp;
+    w->len = 0;
+}
+
+void writer_flush(OutputWriter *w) {
+    if (w->len > 0) fwrite(w->buf, 1, w->len, w->fp);
+    w->len = 0;
+}
+
+void writer_write(OutputWriter *w, const void *data, size_t len) {
+    if (w->len + len > OUTPUT_BUFFER_SIZE) {
+        writer_flush(w);
+        if (len > OUTPUT_BUFFER_SIZE) { fwrite(data, 1, len, w->fp); return; }
+    }
+    memcpy(w->buf + w->len, data, len);
+    w->len += len;
+}
+
+void writer_puts(OutputWriter *w, const char *s) {
+    writer_write(w, s, strlen(s));
+}
+
+void writer_char(OutputWriter *w, char c) {
+    if (w->len == OUTPUT_BUFFER_SIZE) writer_flush(w);
+    w->buf[w->len++] = c;
+}
+
+void writer_int(OutputWriter *w, int value) {
+    char digits[12];
+    int pos = sizeof(digits);
+    unsigned u = value < 0 ? 0u - (unsigned)value : (unsigned)value;
+    do {
+        digits[--pos] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (value < 0) digits[--pos] = '-';
+    writer_write(w, digits + pos, sizeof(digits) - pos);
+}
+
+void writer_printf(OutputWriter *w, const char *fmt, ...) {
+    char line[512];
+    va_list ap;
+    va_start(ap, fmt);
+    int len = vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+    if (len < 0) return;
+    writer_write(w, line, (size_t)len < sizeof(line) ? (size_t)len : sizeof(line) - 1);
+}
+
+// ================== Schedule formats ==================
+
+// Start times, one job per line (the format every solver already writes).
+void write_schedule_text(OutputWriter *w, ScheduleView v) {
+    for (int j = 0; j < v.num_jobs; j++) {
+        for (int i = 0; i < v.num_ops; i++) {
+            writer_int(w, VIEW_OP(v, j, i).start);
+            writer_char(w, ' ');
+        }
+        writer_char(w, '\n');
+    }
+}
+
+/*
+    Gantt chart with one column per `resolution` time units. Each machine row
+    walks its sorted timeline once, so the cost is O(M * columns + N) instead
+    of rescanning every operation for every column.
+*/
+void write_gantt_chart(OutputWriter *w, const MachineTimeline *tl, int resolution) {
+    if (resolution < 1) resolution = 1;
+    int makespan = tl->makespan;
+    int blocks = (makespan + resolution - 1) / resolution;
+
+    writer_printf(w, "\n# Gantt Chart (1 char = %d time units)\n", resolution);
+    for (int m = 0; m < tl->num_machines; m++) {
+        writer_printf(w, "Machine %2d |", m);
+        int e = tl->machine_begin[m];
+        int last = tl->machine_begin[m + 1];
+        for (int b = 0; b < blocks; b++) {
+            int t_start = b * resolution;
+            int t_end = t_start + resolution;
+            while (e < last && tl->entries[e].end <= t_start) e++;
+            if (e < last && tl->entries[e].start < t_end) {
+                writer_char(w, 'J');
+                writer_int(w, tl->entries[e].job);
+            } else {
+                writer_puts(w, "  ");
+            }
+        }
+        writer_puts(w, "|\n");
+    }
+    writer_puts(w, "\nTime       ");
+    for (int b = 0; b < blocks; b++) {
+        int label = b * resolution;
+        writer_puts(w, label < 10 ? "  " : label < 100 ? " " : "");
+        writer_int(w, label);
+    }
+    writer_char(w, ' ');
+    writer_int(w, makespan);
+    writer_char(w, '\n');
+}
+
+static void put_u16(unsigned char *p, unsigned v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+}
+
+static void put_u32(unsigned char *p, uint32_t v) {
+    for (int b = 0; b < 4; b++) p[b] = (unsigned char)(v >> (8 * b));
+}
+
+static uint32_t get_u32(const unsigned char *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+int write_schedule_binary(const char *filename, ScheduleView v, int makespan) {
+    FILE *fp = fopen(filename, "wb");
+    if (!fp) return -1;
+
+    OutputWriter w;
+    writer_init(&w, fp);
+
+    unsigned char header[20];
+    memcpy(header, "JSB1", 4);
+    put_u32(header + 4, (uint32_t)v.num_jobs);
+    put_u32(header + 8, (uint32_t)v.num_ops);
+    put_u32(header + 12, (uint32_t)v.num_machines);
+    put_u32(header + 16, (uint32_t)makespan);
+    writer_write(&w, header, sizeof(header));
+
+    unsigned char rec[JSB_RECORD_SIZE];
+    for (int j = 0; j < v.num_jobs; j++) {
+        for (int i = 0; i < v.num_ops; i++) {
+            const Operation *o = &VIEW_OP(v, j, i);
+            put_u16(rec, (unsigned)o->machine);
+            put_u32(rec + 2, (uint32_t)o->start);
+            put_u32(rec + 6, (uint32_t)o->duration);
+            writer_write(&w, rec, sizeof(rec));
+        }
+    }
+    writer_flush(&w);
+    return fclose(fp) == 0 ? 0 : -1;
+}
+
+// Reads a .jsb file into table (rows of `stride` operations). Returns 0 on success.
+int read_schedule_binary(const char *filename, Operation *table, int stride, int max_jobs,
+                         int *num_jobs, int *num_ops, int *num_machines, int *makespan) {
+    FILE *fp = fopen(filename, "rb");
+    if (!fp) return -1;
+
+    unsigned char header[20];
+    if (fread(header, 1, sizeof(header), fp) != sizeof(header) || memcmp(header, "JSB1", 4) != 0) {
+        fclose(fp);
+        return -1;
+    }
+    *num_jobs = (int)get_u32(header + 4);
+    *num_ops = (int)get_u32(header + 8);
+    *num_machines = (int)get_u32(header + 12);
+    *makespan = (int)get_u32(header + 16);
+    if (*num_jobs > max_jobs || *num_ops > stride) { fclose(fp); return -1; }
+
+    unsigned char rec[JSB_RECORD_SIZE];
+    for (int j = 0; j < *num_jobs; j++) {
+        for (int i = 0; i < *num_ops; i++) {
+            if (fread(rec, 1, sizeof(rec), fp) != sizeof(rec)) { fclose(fp); return -1; }
+            Operation *o = &table[j * stride + i];
+            o->machine = rec[0] | rec[1] << 8;
+            o->start = (int)get_u32(rec + 2);
+            o->duration = (int)get_u32(rec + 6);
+            o->end = o->start + o->duration;
+        }
+    }
+    fclose(fp);
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*
+    Schedule output layer.
+
+    - MachineTimeline: the operations of a schedule grouped per machine and
+      sorted by start time, built once in O(N) with a counting/radix sort.
+    - OutputWriter: one buffered writer, so the per-operation numbers are not
+      each a separate fprintf call.
+    - Text output (same layout as before), optional Gantt chart with a
+      configurable resolution, and a compact binary schedule (.jsb) for
+      downstream tools.
+
+    Binary format (.jsb, little-endian):
+        char     magic[4]      "JSB1"
+        uint32   num_jobs, num_ops, num_machines, makespan
+        then num_jobs * num_ops records in job order:
+        uint16   machine
+        uint32   start
+        uint32   duration
+*/
+
+#ifndef SCHEDULE_OUTPUT_H
+#define SCHEDULE_OUTPUT_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "jobshop.h"
+
+#define OUTPUT_BUFFER_SIZE  (1 << 16)
+#define JSB_RECORD_SIZE     10
+
+typedef struct {
+    int job;
+    int op;
+    int start;
+    int end;
+} TimelineEntry;
+
+// Large (about 2.3 MB): declare instances static, never on the stack.
+typedef struct {
+    int num_machines;
+    int count;
+    int makespan;
+    int machine_begin[JSS_MAX_MACHINES + 1];   // entries of machine m: [begin[m], begin[m+1])
+    TimelineEntry entries[JSS_MAX_OPERATIONS];
+    TimelineEntry scratch[JSS_MAX_OPERATIONS];
+    int machine_of[JSS_MAX_OPERATIONS];
+    int radix_count[1 << 16];
+} MachineTimeline;
+
+typedef struct {
+    FILE *fp;
+    size_t len;
+    char buf[OUTPUT_BUFFER_SIZE];
+} OutputWriter;
+
+// ================== Timeline ==================
+int  build_timeline(MachineTimeline *tl, ScheduleView v);
+
+// ================== Buffered writer ==================
+void writer_init(OutputWriter *w, FILE *fp);
+void writer_write(OutputWriter *w, const void *data, size_t len);
+void writer_puts(OutputWriter *w, const char *s);
+void writer_char(OutputWriter *w, char c);
+void writer_int(OutputWriter *w, int value);
+void writer_printf(OutputWriter *w, const char *fmt, ...);
+void writer_flush(OutputWriter *w);
+
+// ================== Schedule formats ==================
+void write_schedule_text(OutputWriter *w, ScheduleView v);
+void write_gantt_chart(OutputWriter *w, const MachineTimeline *tl, int resolution);
+int  write_schedule_binary(const char *filename, ScheduleView v, int makespan);
+int  read_schedule_binary(const char *filename, Operation *table, int stride, int max_jobs,
+                          int *num_jobs, int *num_ops, int *num_machines, int *makespan);
+
+#endif
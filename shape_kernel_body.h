@@ -0,0 +1,42 @@
+/*
+    Kernel bodies instantiated by shape_kernels.c, once per shape (no
+    include guard). Before including, define
+        SHAPE_FN(name)  the name of the instance of a kernel
+        SHAPE_JOBS      job count: a constant, or the num_jobs parameter
+        SHAPE_OPS       operations per job: a constant, or num_ops
+*/
+
+int SHAPE_FN(list_schedule)(Operation *table, int stride, int num_jobs, int num_ops) {
+    (void)num_jobs; (void)num_ops;   // unused when the shape is fixed
+    int machine_ready[JSS_MAX_MACHINES];
+    for (int m = 0; m < SHAPE_OPS; m++) machine_ready[m] = 0;
+
+    int makespan = 0;
+    for (int j = 0; j < SHAPE_JOBS; j++) {
+        Operation *row = table + j * stride;
+        int job_ready = 0;
+        for (int i = 0; i < SHAPE_OPS; i++) {
+            int m = row[i].machine;
+            int start = machine_ready[m] > job_ready ? machine_ready[m] : job_ready;
+            job_ready = start + row[i].duration;
+            row[i].start = start;
+            row[i].end = job_ready;
+            machine_ready[m] = job_ready;
+        }
+        if (job_ready > makespan) makespan = job_ready;
+    }
+    return makespan;
+}
+
+void SHAPE_FN(expand)(const Operation *table, int stride, int num_jobs, int num_ops,
+                      const int *job_progress, const int *job_ready, const int *machine_ready,
+                      int *start, int *end) {
+    (void)num_jobs; (void)num_ops;
+    for (int j = 0; j < SHAPE_JOBS; j++) {
+        int i = job_progress[j];
+        const Operation *op = table + j * stride + (i < SHAPE_OPS ? i : 0);
+        int s = machine_ready[op->machine] > job_ready[j] ? machine_ready[op->machine] : job_ready[j];
+        start[j] = i < SHAPE_OPS ? s : INT_MAX;
+        end[j] = i < SHAPE_OPS ? s + op->duration : INT_MAX;
+    }
+}
@@ -0,0 +1,73 @@
+/*
+    Shape-specialized kernels (see shape_kernels.h): one instance of
+    shape_kernel_body.h per shape, with constant bounds, and the generic one.
+*/
+
+#include <limits.h>
+#include "shape_kernels.h"
+
+#define SHAPE_FN(name) name##_generic
+#define SHAPE_JOBS num_jobs
+#define SHAPE_OPS  num_ops
+#include "shape_kernel_body.h"
+#undef SHAPE_FN
+#undef SHAPE_JOBS
+#undef SHAPE_OPS
+
+#define SHAPE_FN(name) name##_6x6
+#define SHAPE_JOBS 6
+#define SHAPE_OPS  6
+#include "shape_kernel_body.h"
+#undef SHAPE_FN
+#undef SHAPE_JOBS
+#undef SHAPE_OPS
+
+#define SHAPE_FN(name) name##_10x10
+#define SHAPE_JOBS 10
+#define SHAPE_OPS  10
+#include "shape_kernel_body.h"
+#undef SHAPE_FN
+#undef SHAPE_JOBS
+#undef SHAPE_OPS
+
+#define SHAPE_FN(name) name##_15x15
+#define SHAPE_JOBS 15
+#define SHAPE_OPS  15
+#include "shape_kernel_body.h"
+#undef SHAPE_FN
+#undef SHAPE_JOBS
+#undef SHAPE_OPS
+
+#define SHAPE_FN(name) name##_20x20
+#define SHAPE_JOBS 20
+#define SHAPE_OPS  20
+#include "shape_kernel_body.h"
+#undef SHAPE_FN
+#undef SHAPE_JOBS
+#undef SHAPE_OPS
+
+#define SHAPE_FN(name) name##_50x15
+#define SHAPE_JOBS 50
+#define SHAPE_OPS  15
+#include "shape_kernel_body.h"
+#undef SHAPE_FN
+#undef SHAPE_JOBS
+#undef SHAPE_OPS
+
+static const ShapeKernels shapes[] = {
+    { "6x6",   6,  6,  list_schedule_6x6,   expand_6x6 },
+    { "10x10", 10, 10, list_schedule_10x10, expand_10x10 },
+    { "15x15", 15, 15, list_schedule_15x15, expand_15x15 },
+    { "20x20", 20, 20, list_schedule_20x20, expand_20x20 },
+    { "50x15", 50, 15, list_schedule_50x15, expand_50x15 },
+};
+
+ShapeKernels shape_kernels_generic(void) {
+    return (ShapeKernels){ "generic", 0, 0, list_schedule_generic, expand_generic };
+}
+
+ShapeKernels shape_kernels_select(int num_jobs, int num_machines) {
+    for (int s = 0; s < (int)(sizeof(shapes) / sizeof(shapes[0])); s++)
+        if (shapes[s].num_jobs == num_jobs && shapes[s].num_machines == num_machines) return shapes[s];
+    return shape_kernels_generic();
+}
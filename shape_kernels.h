@@ -0,0 +1,46 @@
+/*
+    Solver kernels specialized for fixed instance shapes.
+
+    Most production instances come in a few shapes (jobs x machines, one
+    operation per machine): 6x6, 10x10, 15x15, 20x20 and 50x15. For each of
+    them shape_kernels.c compiles the kernels below with the loop bounds as
+    compile-time constants, so the compiler can unroll and vectorize them;
+    any other shape gets the generic build with run-time bounds. All builds
+    come from the same body (shape_kernel_body.h) and give identical
+    results.
+
+    - list_schedule(): sequential_schedule(), the job-order list schedule.
+      Writes start/end of every operation and returns the makespan.
+    - expand(): the node expansion of branch_and_bound(): the append start
+      max(machine_ready, job_ready) and end of the next operation of every
+      job (INT_MAX for finished jobs).
+
+    Tables are passed as &table[0][0] plus their row stride (MAX_OPS of the
+    caller), like ScheduleView. The driver picks the kernels once, after
+    read_input():
+
+        ShapeKernels kernels = shape_kernels_select(num_jobs, num_machines);
+        int makespan = kernels.list_schedule(&ops[0][0], MAX_OPS, num_jobs, num_ops);
+*/
+
+#ifndef SHAPE_KERNELS_H
+#define SHAPE_KERNELS_H
+
+#include "jobshop.h"
+
+typedef int  (*ListScheduleKernel)(Operation *table, int stride, int num_jobs, int num_ops);
+typedef void (*ExpandKernel)(const Operation *table, int stride, int num_jobs, int num_ops,
+                             const int *job_progress, const int *job_ready, const int *machine_ready,
+                             int *start, int *end);
+
+typedef struct {
+    const char *name;          // "10x10", ... or "generic"
+    int num_jobs, num_machines;
+    ListScheduleKernel list_schedule;
+    ExpandKernel expand;
+} ShapeKernels;
+
+ShapeKernels shape_kernels_select(int num_jobs, int num_machines);   // generic when no shape matches
+ShapeKernels shape_kernels_generic(void);
+
+#endif
@@ -0,0 +1,247 @@
+/*
+    Flexible Job-Shop model: .fjs reader and active-schedule decoder (see fjsp.h).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fjsp.h"
+#include "../counter_rng.h"
+
+// ================== Input ==================
+int fjsp_read(const char *filename, FjspInstance *inst) {
+    FILE *fp = fopen(filename, "r");
+    if (!fp) { perror("Error opening input file"); return -1; }
+
+    char line[256];
+    if (!fgets(line, sizeof(line), fp) ||
+        sscanf(line, "%d %d", &inst->num_jobs, &inst->num_machines) != 2 ||
+        inst->num_jobs < 1 || inst->num_jobs > FJSP_MAX_JOBS ||
+        inst->num_machines < 1 || inst->num_machines > FJSP_MAX_MACHINES) {
+        fprintf(stderr, "Invalid .fjs header\n");
+        fclose(fp);
+        return -1;
+    }
+
+    inst->total_ops = 0;
+    for (int j = 0; j < inst->num_jobs; j++) {
+        Job *job = &inst->jobs[j];
+        if (fscanf(fp, "%d", &job->num_ops) != 1 || job->num_ops < 1 || job->num_ops > FJSP_MAX_OPS) {
+            fprintf(stderr, "Invalid operation count for job %d\n", j);
+            fclose(fp);
+            return -1;
+        }
+        for (int o = 0; o < job->num_ops; o++) {
+            FlexOperation *op = &job->ops[o];
+            if (fscanf(fp, "%d", &op->num_alts) != 1 || op->num_alts < 1 || op->num_alts > FJSP_MAX_ALTS) {
+                fprintf(stderr, "Invalid alternatives for job %d op %d\n", j, o);
+                fclose(fp);
+                return -1;
+            }
+            for (int k = 0; k < op->num_alts; k++) {
+                int m, t;
+                if (fscanf(fp, "%d %d", &m, &t) != 2 || m < 1 || m > inst->num_machines) {
+                    fprintf(stderr, "Invalid alternative for job %d op %d\n", j, o);
+                    fclose(fp);
+                    return -1;
+                }
+                op->alts[k].machine = m - 1;   // .fjs machines are 1-based
+                op->alts[k].proc_time = t;
+            }
+        }
+        inst->total_ops += job->num_ops;
+    }
+    fclose(fp);
+    return 0;
+}
+
+// ================== Decoder ==================
+
+/*
+    Active decoding: operations are taken in sequence order and each one is
+    placed in the first gap of its machine that starts no earlier than the
+    job's previous operation ends and is long enough. Returns the makespan.
+*/
+int fjsp_decode(const FjspInstance *inst, const FjspSolution *sol, FjspDecoder *dec) {
+    for (int m = 0; m < inst->num_machines; m++) dec->machine_head[m] = -1;
+    for (int j = 0; j < inst->num_jobs; j++) {
+        dec->job_ready[j] = 0;
+        dec->job_next_op[j] = 0;
+    }
+
+    int makespan = 0;
+    for (int k = 0; k < inst->total_ops; k++) {
+        int j = sol->sequence[k];
+        int o = dec->job_next_op[j]++;
+        const Alternative *alt = &inst->jobs[j].ops[o].alts[sol->assignment[j][o]];
+        int m = alt->machine, p = alt->proc_time;
+
+        // Walk the machine's busy intervals (sorted by start) for the first fitting gap
+        int prev = -1, cur = dec->machine_head[m];
+        int t = dec->job_ready[j];
+        while (cur >= 0) {
+            if (t + p <= dec->slot_start[cur]) break;          // fits before cur
+            if (dec->slot_end[cur] > t) t = dec->slot_end[cur];
+            prev = cur;
+            cur = dec->next[cur];
+        }
+
+        dec->slot_start[k] = t;
+        dec->slot_end[k] = t + p;
+        dec->slot_job[k] = j;
+        dec->next[k] = cur;
+        if (prev >= 0) dec->next[prev] = k;
+        else dec->machine_head[m] = k;
+
+        dec->start[j][o] = t;
+        dec->job_ready[j] = t + p;
+        if (t + p > makespan) makespan = t + p;
+    }
+    return makespan;
+}
+
+// Checks job order and machine capacity of a decoded schedule. 1 if valid.
+int fjsp_check(const FjspInstance *inst, const FjspSolution *sol, const FjspDecoder *dec) {
+    for (int j = 0; j < inst->num_jobs; j++) {
+        int ready = 0;
+        for (int o = 0; o < inst->jobs[j].num_ops; o++) {
+            if (dec->start[j][o] < ready) return 0;
+            ready = dec->start[j][o] + inst->jobs[j].ops[o].alts[sol->assignment[j][o]].proc_time;
+        }
+    }
+    for (int m = 0; m < inst->num_machines; m++) {
+        for (int s = dec->machine_head[m]; s >= 0 && dec->next[s] >= 0; s = dec->next[s])
+            if (dec->slot_end[s] > dec->slot_start[dec->next[s]]) return 0;
+    }
+    return 1;
+}
+
+// Random machine assignment and a random operation order (Fisher-Yates).
+void fjsp_random_solution(const FjspInstance *inst, FjspSolution *sol, unsigned long long *rng) {
+    int k = 0;
+    for (int j = 0; j < inst->num_jobs; j++) {
+        for (int o = 0; o < inst->jobs[j].num_ops; o++) {
+            sol->assignment[j][o] = (int)(fjsp_rand(rng) % inst->jobs[j].ops[o].num_alts);
+            sol->sequence[k++] = j;
+        }
+    }
+    for (int a = inst->total_ops - 1; a > 0; a--) {
+        int b = (int)(fjsp_rand(rng) % (a + 1));
+        int tmp = sol->sequence[a];
+        sol->sequence[a] = sol->sequence[b];
+        sol->sequence[b] = tmp;
+    }
+    sol->makespan = -1;
+}
+
+/*
+    Instance of paralelOMP.c / paralleled.c: every operation may run on every
+    machine, with times uniform in [1, max_time]. Times come from
+    counter_rng.h (stream = job, counter = op * machines + machine), so a
+    seed gives the same instance in every program and for any thread count.
+*/
+void fjsp_random_instance(FjspInstance *inst, int jobs, int ops, int machines, int max_time, unsigned long long seed) {
+    inst->num_jobs = jobs;
+    inst->num_machines = machines;
+    inst->total_ops = jobs * ops;
+    for (int j = 0; j < jobs; j++) {
+        inst->jobs[j].num_ops = ops;
+        for (int o = 0; o < ops; o++) {
+            inst->jobs[j].ops[o].num_alts = machines;
+            for (int k = 0; k < machines; k++) {
+                inst->jobs[j].ops[o].alts[k].machine = k;
+                inst->jobs[j].ops[o].alts[k].proc_time = crng_range(seed, j, (uint64_t)o * machines + k, 1, max_time);
+            }
+        }
+    }
+}
+
+// ================== Job-order replay with delta evaluation ==================
+
+// Replays job j on the profile in place; returns the job's completion time.
+static int replay_job(const FjspInstance *inst, const int *job_assignment, int j,
+                      int override_op, int override_alt, int *machine_avail) {
+    int time = 0;
+    for (int o = 0; o < inst->jobs[j].num_ops; o++) {
+        int a = o == override_op ? override_alt : job_assignment[o];
+        const Alternative *alt = &inst->jobs[j].ops[o].alts[a];
+        int start = machine_avail[alt->machine] > time ? machine_avail[alt->machine] : time;
+        time = start + alt->proc_time;
+        machine_avail[alt->machine] = time;
+    }
+    return time;
+}
+
+static void rebuild_maxima(const FjspInstance *inst, FjspReplay *r) {
+    int n = inst->num_jobs;
+    r->prefix_max[0] = 0;
+    for (int j = 0; j < n; j++)
+        r->prefix_max[j + 1] = r->prefix_max[j] > r->job_finish[j] ? r->prefix_max[j] : r->job_finish[j];
+    r->suffix_max[n] = 0;
+    for (int j = n - 1; j >= 0; j--)
+        r->suffix_max[j] = r->suffix_max[j + 1] > r->job_finish[j] ? r->suffix_max[j + 1] : r->job_finish[j];
+    r->makespan = r->prefix_max[n];
+}
+
+// Full replay from scratch, recording the profile before every job.
+void fjsp_replay_init(const FjspInstance *inst, FjspReplay *r, int assignment[][FJSP_MAX_OPS]) {
+    size_t row = inst->num_machines * sizeof(int);
+    for (int j = 0; j < inst->num_jobs; j++)
+        memcpy(r->assignment[j], assignment[j], inst->jobs[j].num_ops * sizeof(int));
+    memset(r->profile[0], 0, row);
+    for (int j = 0; j < inst->num_jobs; j++) {
+        memcpy(r->profile[j + 1], r->profile[j], row);
+        r->job_finish[j] = replay_job(inst, r->assignment[j], j, -1, 0, r->profile[j + 1]);
+    }
+    rebuild_maxima(inst, r);
+}
+
+/*
+    Makespan if operation (job, op) used alternative alt; r is not modified.
+    Only the affected suffix is replayed: as soon as the machine profile
+    after a job equals the stored one, every later job is unchanged and its
+    contribution is the stored suffix maximum.
+
+    The result is exact when it is below cutoff; otherwise the replay may stop
+    early and return any value >= cutoff. Start times only grow with the
+    machine profile, so once the replayed profile is nowhere earlier than the
+    stored one the stored suffix maximum is a lower bound for the rest.
+*/
+int fjsp_replay_delta(const FjspInstance *inst, const FjspReplay *r, int job, int op, int alt, int cutoff) {
+    int machine_avail[FJSP_MAX_MACHINES];
+    int m_count = inst->num_machines;
+    memcpy(machine_avail, r->profile[job], m_count * sizeof(int));
+
+    int makespan = r->prefix_max[job];
+    for (int j = job; j < inst->num_jobs; j++) {
+        int finish = replay_job(inst, r->assignment[j], j, j == job ? op : -1, alt, machine_avail);
+        if (finish > makespan) makespan = finish;
+        if (makespan >= cutoff) return makespan;
+
+        const int *stored = r->profile[j + 1];
+        int same = 1, not_earlier = 1;
+        for (int m = 0; m < m_count; m++) {
+            if (machine_avail[m] != stored[m]) same = 0;
+            if (machine_avail[m] < stored[m]) { not_earlier = 0; break; }
+        }
+        int rest = r->suffix_max[j + 1];
+        if (same) return makespan > rest ? makespan : rest;
+        if (not_earlier && rest >= cutoff) return rest;
+    }
+    return makespan;
+}
+
+// Commits the change and repairs the stored profiles of the affected suffix.
+void fjsp_replay_apply(const FjspInstance *inst, FjspReplay *r, int job, int op, int alt) {
+    size_t row = inst->num_machines * sizeof(int);
+    r->assignment[job][op] = alt;
+    for (int j = job; j < inst->num_jobs; j++) {
+        int machine_avail[FJSP_MAX_MACHINES];
+        memcpy(machine_avail, r->profile[j], row);
+        r->job_finish[j] = replay_job(inst, r->assignment[j], j, -1, 0, machine_avail);
+        int same = memcmp(machine_avail, r->profile[j + 1], row) == 0;
+        memcpy(r->profile[j + 1], machine_avail, row);
+        if (same) break;   // later jobs see the same machines: unchanged
+    }
+    rebuild_maxima(inst, r);
+}
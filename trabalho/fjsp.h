@@ -0,0 +1,107 @@
+/*
+    Flexible Job-Shop (FJSP) model and decoder.
+
+    Same model as sequenc2.c / paralelOMP.c / paralleled.c: every operation has
+    a list of Alternative {machine, proc_time}; here the lists are static
+    arrays instead of malloc'd pointers.
+
+    A solution has two parts:
+    - assignment[j][o]: chosen alternative of operation o of job j
+    - sequence[]: operation order as a list of job ids, where the k-th
+      occurrence of job j stands for its k-th operation
+    fjsp_decode() turns it into an active schedule: each operation is inserted
+    into the earliest idle gap of its machine that respects the job order.
+
+    Brandimarte .fjs format:
+        num_jobs num_machines [avg machines per operation]
+        per job: num_ops, then per operation: k  machine_1 time_1 ... machine_k time_k
+    (machines numbered from 1).
+*/
+
+#ifndef FJSP_H
+#define FJSP_H
+
+#include "../cache_layout.h"
+
+#define FJSP_MAX_JOBS     100
+#define FJSP_MAX_OPS      100
+#define FJSP_MAX_MACHINES 20
+#define FJSP_MAX_ALTS     FJSP_MAX_MACHINES
+#define FJSP_MAX_TOTAL    (FJSP_MAX_JOBS * FJSP_MAX_OPS)
+
+typedef struct {
+    int machine;
+    int proc_time;
+} Alternative;
+
+typedef struct {
+    Alternative alts[FJSP_MAX_ALTS];
+    int num_alts;
+} FlexOperation;
+
+typedef struct {
+    FlexOperation ops[FJSP_MAX_OPS];
+    int num_ops;
+} Job;
+
+typedef struct {
+    int num_jobs;
+    int num_machines;
+    int total_ops;
+    Job jobs[FJSP_MAX_JOBS];
+} FjspInstance;
+
+typedef struct {
+    int assignment[FJSP_MAX_JOBS][FJSP_MAX_OPS];
+    int sequence[FJSP_MAX_TOTAL];
+    int makespan;
+} FjspSolution;
+
+// Decoder workspace: per-machine interval lists linked through op slots.
+// Cache-line aligned: per-thread arrays of decoders share no line.
+typedef struct {
+    CACHE_ALIGNED int start[FJSP_MAX_JOBS][FJSP_MAX_OPS];
+    int machine_head[FJSP_MAX_MACHINES];
+    int next[FJSP_MAX_TOTAL];
+    int slot_start[FJSP_MAX_TOTAL];
+    int slot_end[FJSP_MAX_TOTAL];
+    int slot_job[FJSP_MAX_TOTAL];
+    int job_ready[FJSP_MAX_JOBS];
+    int job_next_op[FJSP_MAX_JOBS];
+} FjspDecoder;
+
+/*
+    Job-order replay model of paralelOMP.c / paralleled.c: jobs are replayed
+    in index order and each operation starts when both its job and its machine
+    are free. FjspReplay keeps the machine availability profile before every
+    job plus prefix/suffix maxima of the job completion times, so changing one
+    operation's alternative only replays job j and the following jobs until
+    the profile matches the stored one again.
+*/
+typedef struct {
+    CACHE_ALIGNED int assignment[FJSP_MAX_JOBS][FJSP_MAX_OPS];   // aligned like FjspDecoder
+    int profile[FJSP_MAX_JOBS + 1][FJSP_MAX_MACHINES];   // machine availability before job j
+    int job_finish[FJSP_MAX_JOBS];
+    int prefix_max[FJSP_MAX_JOBS + 1];                   // max finish of jobs < j
+    int suffix_max[FJSP_MAX_JOBS + 1];                   // max finish of jobs >= j
+    int makespan;
+} FjspReplay;
+
+int  fjsp_read(const char *filename, FjspInstance *inst);
+int  fjsp_decode(const FjspInstance *inst, const FjspSolution *sol, FjspDecoder *dec);
+int  fjsp_check(const FjspInstance *inst, const FjspSolution *sol, const FjspDecoder *dec);
+void fjsp_replay_init(const FjspInstance *inst, FjspReplay *r, int assignment[][FJSP_MAX_OPS]);
+int  fjsp_replay_delta(const FjspInstance *inst, const FjspReplay *r, int job, int op, int alt, int cutoff);
+void fjsp_replay_apply(const FjspInstance *inst, FjspReplay *r, int job, int op, int alt);
+void fjsp_random_solution(const FjspInstance *inst, FjspSolution *sol, unsigned long long *rng);
+void fjsp_random_instance(FjspInstance *inst, int jobs, int ops, int machines, int max_time, unsigned long long seed);
+
+static inline unsigned long long fjsp_rand(unsigned long long *state) {
+    // xorshift64*
+    unsigned long long x = *state;
+    x ^= x >> 12; x ^= x << 25; x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+#endif
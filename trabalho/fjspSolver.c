@@ -0,0 +1,173 @@
+/*
+    Flexible Job-Shop Scheduler in C (OpenMP) - two-level parallel local search
+
+    Model and decoder in fjsp.c (Alternative/operation model of sequenc2.c,
+    static arrays instead of malloc'd alternative lists).
+
+    Each thread runs an independent search from its own random solution:
+    - outer level: reassign one operation to another of its alternatives
+    - inner level: INNER_STEPS resequencing moves (swap two operations of
+      different jobs in the operation order) to adapt to the new assignment
+    The outer move is kept if the result is no worse than before; after
+    STAGNATION_LIMIT outer moves without improvement the thread restarts from
+    its best solution with a random perturbation. Threads keep their own best
+    and the global best is reduced once at the end.
+
+    gcc -fopenmp -Wall -O2 -o fjspSolver fjspSolver.c fjsp.c
+    ./fjspSolver mk01.fjs out.txt 4 2000 [seed]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <omp.h>
+#include "fjsp.h"
+
+#define MAX_THREADS      64
+#define INNER_STEPS      20
+#define STAGNATION_LIMIT 200
+#define PERTURB_MOVES    5
+
+FjspInstance instance;
+FjspSolution best_solution;
+int best_makespan = INT_MAX;
+FjspDecoder decoders[MAX_THREADS];   // one workspace per thread
+
+// Copies only the part of a solution that the instance uses.
+void copy_solution(const FjspInstance *inst, FjspSolution *dst, const FjspSolution *src) {
+    for (int j = 0; j < inst->num_jobs; j++)
+        memcpy(dst->assignment[j], src->assignment[j], inst->jobs[j].num_ops * sizeof(int));
+    memcpy(dst->sequence, src->sequence, inst->total_ops * sizeof(int));
+    dst->makespan = src->makespan;
+}
+
+// Random operation with more than one alternative; 0 if the instance has none.
+int pick_flexible_op(const FjspInstance *inst, unsigned long long *rng, int *job, int *op) {
+    for (int tries = 0; tries < 64; tries++) {
+        int j = (int)(fjsp_rand(rng) % inst->num_jobs);
+        int o = (int)(fjsp_rand(rng) % inst->jobs[j].num_ops);
+        if (inst->jobs[j].ops[o].num_alts > 1) { *job = j; *op = o; return 1; }
+    }
+    return 0;
+}
+
+void reassign(const FjspInstance *inst, FjspSolution *sol, unsigned long long *rng) {
+    int j, o;
+    if (!pick_flexible_op(inst, rng, &j, &o)) return;
+    int n = inst->jobs[j].ops[o].num_alts;
+    sol->assignment[j][o] = (sol->assignment[j][o] + 1 + (int)(fjsp_rand(rng) % (n - 1))) % n;
+}
+
+// Inner level: swap moves on the operation order, accepted when not worse.
+void resequence(const FjspInstance *inst, FjspSolution *sol, FjspDecoder *dec, unsigned long long *rng) {
+    for (int s = 0; s < INNER_STEPS; s++) {
+        int a = (int)(fjsp_rand(rng) % inst->total_ops);
+        int b = (int)(fjsp_rand(rng) % inst->total_ops);
+        if (sol->sequence[a] == sol->sequence[b]) continue;
+        int tmp = sol->sequence[a];
+        sol->sequence[a] = sol->sequence[b];
+        sol->sequence[b] = tmp;
+        int makespan = fjsp_decode(inst, sol, dec);
+        if (makespan <= sol->makespan) {
+            sol->makespan = makespan;
+        } else {
+            sol->sequence[b] = sol->sequence[a];
+            sol->sequence[a] = tmp;
+        }
+    }
+}
+
+void local_search(int tid, long long iterations, unsigned long long seed) {
+    static _Thread_local FjspSolution current, saved, local_best;
+    FjspDecoder *dec = &decoders[tid];
+    unsigned long long rng = seed ^ (0x9E3779B97F4A7C15ULL * (unsigned long long)(tid + 1));
+    if (rng == 0) rng = 1;
+
+    fjsp_random_solution(&instance, &current, &rng);
+    current.makespan = fjsp_decode(&instance, &current, dec);
+    copy_solution(&instance, &local_best, &current);
+
+    int stagnation = 0;
+    for (long long it = 0; it < iterations; it++) {
+        copy_solution(&instance, &saved, &current);
+        reassign(&instance, &current, &rng);
+        current.makespan = fjsp_decode(&instance, &current, dec);
+        resequence(&instance, &current, dec, &rng);
+
+        if (current.makespan > saved.makespan) copy_solution(&instance, &current, &saved);
+
+        if (current.makespan < local_best.makespan) {
+            copy_solution(&instance, &local_best, &current);
+            stagnation = 0;
+        } else if (++stagnation >= STAGNATION_LIMIT) {
+            // Restart from the thread's best with a few random reassignments
+            copy_solution(&instance, &current, &local_best);
+            for (int p = 0; p < PERTURB_MOVES; p++) reassign(&instance, &current, &rng);
+            current.makespan = fjsp_decode(&instance, &current, dec);
+            stagnation = 0;
+        }
+    }
+
+    // Reduction: one critical section per thread
+    #pragma omp critical
+    {
+        if (local_best.makespan < best_makespan) {
+            best_makespan = local_best.makespan;
+            copy_solution(&instance, &best_solution, &local_best);
+        }
+    }
+}
+
+void write_output(const char *filename, double elapsed, int threads, long long iterations) {
+    FILE *fp = fopen(filename, "w");
+    if (!fp) { perror("Error opening output file"); exit(1); }
+
+    // Decode once more for the start times of the final schedule
+    FjspDecoder *dec = &decoders[0];
+    fjsp_decode(&instance, &best_solution, dec);
+
+    fprintf(fp, "%d\n", best_makespan);
+    fprintf(fp, "# start(machine) per operation, one job per line\n");
+    for (int j = 0; j < instance.num_jobs; j++) {
+        for (int o = 0; o < instance.jobs[j].num_ops; o++) {
+            const Alternative *alt = &instance.jobs[j].ops[o].alts[best_solution.assignment[j][o]];
+            fprintf(fp, "%d(%d) ", dec->start[j][o], alt->machine + 1);
+        }
+        fprintf(fp, "\n");
+    }
+    fprintf(fp, "\n# Performance Analysis\n");
+    fprintf(fp, "Threads: %d | Outer iterations per thread: %lld | Runtime: %.6f seconds\n",
+            threads, iterations, elapsed);
+    fclose(fp);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s input.fjs output.txt num_threads iterations [seed]\n", argv[0]);
+        return 1;
+    }
+    if (fjsp_read(argv[1], &instance) != 0) return 1;
+
+    int threads = atoi(argv[3]);
+    long long iterations = atoll(argv[4]);
+    unsigned long long seed = argc > 5 ? strtoull(argv[5], NULL, 10) : 12345ULL;
+    if (threads < 1 || threads > MAX_THREADS || iterations < 1) {
+        fprintf(stderr, "Invalid parameters. threads must be 1..%d\n", MAX_THREADS);
+        return 1;
+    }
+
+    double t0 = omp_get_wtime();
+    #pragma omp parallel num_threads(threads)
+    local_search(omp_get_thread_num(), iterations, seed);
+    double elapsed = omp_get_wtime() - t0;
+
+    fjsp_decode(&instance, &best_solution, &decoders[0]);
+    if (!fjsp_check(&instance, &best_solution, &decoders[0])) {
+        fprintf(stderr, "Invalid schedule produced\n");
+        return 1;
+    }
+    write_output(argv[2], elapsed, threads, iterations);
+    printf("Best makespan = %d (%.3f s)\n", best_makespan, elapsed);
+    return 0;
+}
@@ -0,0 +1,287 @@
+/*
+    Job-Shop simulated annealing with parallel tempering (OpenMP)
+
+    One replica per thread, each with its own disjunctive graph built from
+    the sequential_schedule() of the Operation instance. Replicas sit on a
+    geometric temperature ladder [tmin, tmax]:
+    - moves: reverse a random machine arc of the critical path (N1). The
+      O(1) dg_swap_estimate() is a lower bound of the new makespan, so a
+      move whose estimate already exceeds the Metropolis threshold is
+      rejected without touching the graph; otherwise dg_swap() updates the
+      heads/tails incrementally and a rejected move is swapped back.
+    - exchanges: every EXCHANGE_STEPS moves all replicas meet at a barrier
+      and one thread tries to swap the temperatures of neighbouring ladder
+      slots (even pairs, then odd pairs on the next round) with the
+      parallel-tempering criterion
+          accept with probability min(1, exp((1/Ti - 1/Tj) * (Ei - Ej))).
+      Only the temperature assignment moves, never the graphs, and there is
+      no lock: between barriers every replica touches only its own state.
+
+    Anytime: the run stops at the time limit, the best schedule seen by any
+    replica is validated and written.
+
+    gcc -fopenmp -Wall -O2 -o mainAnnealing mainAnnealing.c ../schedule_check.c ../schedule_output.c ../disjunctive_graph.c -lm
+
+    ./mainAnnealing ../Matrizes/ta20.jss anneal_ta20.txt 8 10 [tmin] [tmax] [seed]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <omp.h>
+#include "../jobshop.h"
+#include "../counter_rng.h"
+#include "../schedule_check.h"
+#include "../disjunctive_graph.h"
+
+#define MAX_JOBS       1000
+#define MAX_OPS        100
+#define MAX_MACHINES   100
+#define MAX_REPLICAS   64
+#define EXCHANGE_STEPS 2000   // moves per replica between exchange barriers
+
+int num_jobs, num_ops, num_machines;
+Operation ops[MAX_JOBS][MAX_OPS];
+Operation ops_original[MAX_JOBS][MAX_OPS];   // instance as read, never modified
+int machine_available[MAX_MACHINES];
+int job_available[MAX_JOBS];
+
+// Large (about 3.5 MB): one per thread, static, touched only by its thread.
+typedef struct {
+    DisjunctiveGraph graph;
+    int moves[JSS_MAX_OPERATIONS][2];
+    Operation best[JSS_MAX_OPERATIONS];   // row stride num_ops
+    int best_makespan;
+    uint64_t counter;                     // next counter of this replica's RNG stream
+    unsigned long long tried, filtered, accepted;
+} Replica;
+
+Replica replicas[MAX_REPLICAS];
+
+// Temperature ladder: replica_at[slot] runs at temperature[slot].
+double temperature[MAX_REPLICAS];
+int replica_at[MAX_REPLICAS];
+int slot_of[MAX_REPLICAS];
+unsigned long long exchange_tried[MAX_REPLICAS], exchange_accepted[MAX_REPLICAS];
+
+uint64_t seed = 1;
+
+void read_input(const char *fn) {
+    FILE *fp = fopen(fn, "r");
+    if (!fp) { perror("open"); exit(1); }
+    if (fscanf(fp, "%d %d", &num_jobs, &num_machines) != 2 || num_jobs < 1 || num_jobs > MAX_JOBS ||
+        num_machines < 1 || num_machines > MAX_MACHINES || num_jobs * num_machines > JSS_MAX_OPERATIONS) {
+        fprintf(stderr, "Invalid instance header (jobs 1..%d, machines 1..%d)\n", MAX_JOBS, MAX_MACHINES);
+        exit(1);
+    }
+    num_ops = num_machines;
+    for (int j = 0; j < num_jobs; j++) {
+        for (int i = 0; i < num_ops; i++) {
+            if (fscanf(fp, "%d %d", &ops[j][i].machine, &ops[j][i].duration) != 2) {
+                fprintf(stderr, "Truncated instance at job %d op %d\n", j, i);
+                exit(1);
+            }
+            ops_original[j][i] = ops[j][i];
+        }
+    }
+    fclose(fp);
+}
+
+void sequential_schedule() {
+    for (int m = 0; m < num_machines; m++) machine_available[m] = 0;
+    for (int j = 0; j < num_jobs; j++) job_available[j] = 0;
+
+    for (int j = 0; j < num_jobs; j++) {
+        for (int i = 0; i < num_ops; i++) {
+            int m = ops[j][i].machine;
+            int ready = (machine_available[m] > job_available[j]) ? machine_available[m] : job_available[j];
+            ops[j][i].start = ready;
+            ops[j][i].end = ready + ops[j][i].duration;
+            job_available[j] = ops[j][i].end;
+            machine_available[m] = ops[j][i].end;
+        }
+    }
+}
+
+// ================== Annealing ==================
+
+/*
+    Metropolis on the makespan: a move from E to E' is accepted when
+    E' <= E - T ln(r), r uniform in (0, 1]. Drawing r first turns the test
+    into a threshold, which the estimate can already rule out.
+*/
+void anneal(Replica *rep, int replica, double t, int steps) {
+    DisjunctiveGraph *g = &rep->graph;
+    for (int s = 0; s < steps; s++) {
+        int n = dg_critical_arcs(g, rep->moves, JSS_MAX_OPERATIONS);
+        if (n == 0) return;   // one chain without machine arcs: optimal
+        int k = crng_range(seed, replica, rep->counter++, 0, n - 1);
+        int u = rep->moves[k][0], v = rep->moves[k][1];
+        double r = 1.0 - crng_unit(seed, replica, rep->counter++);
+        int threshold = g->makespan + (int)(-t * log(r));
+        rep->tried++;
+
+        if (dg_swap_estimate(g, u, v) > threshold) {
+            rep->filtered++;
+            continue;
+        }
+        int after = dg_swap(g, u, v);
+        if (after < 0) continue;
+        if (after > threshold) {
+            dg_swap(g, v, u);
+            continue;
+        }
+        rep->accepted++;
+        if (after < rep->best_makespan) {
+            rep->best_makespan = after;
+            dg_write_schedule(g, rep->best, num_ops);
+        }
+    }
+}
+
+// Neighbouring ladder slots (parity alternates per round) trade replicas.
+void exchange(int replicas_count, long round) {
+    for (int s = round & 1; s + 1 < replicas_count; s += 2) {
+        int a = replica_at[s], b = replica_at[s + 1];
+        double delta = (1.0 / temperature[s] - 1.0 / temperature[s + 1]) *
+                       (replicas[a].graph.makespan - replicas[b].graph.makespan);
+        exchange_tried[s]++;
+        if (delta >= 0.0 || crng_unit(seed, MAX_REPLICAS, (uint64_t)round * MAX_REPLICAS + s) < exp(delta)) {
+            replica_at[s] = b; replica_at[s + 1] = a;
+            slot_of[b] = s; slot_of[a] = s + 1;
+            exchange_accepted[s]++;
+        }
+    }
+}
+
+// Best makespan over all replicas, printed when it improves (checked at every exchange barrier).
+void report_progress(int replicas_count, double start) {
+    static int reported = INT_MAX;
+    int best = INT_MAX;
+    for (int r = 0; r < replicas_count; r++)
+        if (replicas[r].best_makespan < best) best = replicas[r].best_makespan;
+    if (best < reported) {
+        reported = best;
+        printf("[Incumbent] %d | Elapsed=%.2fs\n", best, omp_get_wtime() - start);
+        fflush(stdout);
+    }
+}
+
+long parallel_tempering(int replicas_count, double tmin, double tmax, double seconds) {
+    static MachineTimeline timeline;
+    sequential_schedule();
+    for (int r = 0; r < replicas_count; r++) {
+        Replica *rep = &replicas[r];
+        dg_build(&rep->graph, SCHEDULE_VIEW(ops, num_jobs, num_ops, num_machines), &timeline);
+        rep->best_makespan = rep->graph.makespan;
+        dg_write_schedule(&rep->graph, rep->best, num_ops);
+        rep->counter = 0;
+        rep->tried = rep->filtered = rep->accepted = 0;
+
+        temperature[r] = replicas_count > 1 ? tmin * pow(tmax / tmin, (double)r / (replicas_count - 1)) : tmin;
+        replica_at[r] = slot_of[r] = r;
+        exchange_tried[r] = exchange_accepted[r] = 0;
+    }
+
+    long rounds = 0;
+    int stop = 0;
+    double start = omp_get_wtime(), deadline = start + seconds;
+    #pragma omp parallel num_threads(replicas_count)
+    {
+        int r = omp_get_thread_num();
+        while (!stop) {
+            anneal(&replicas[r], r, temperature[slot_of[r]], EXCHANGE_STEPS);
+            #pragma omp barrier
+            #pragma omp single
+            {
+                report_progress(replicas_count, start);
+                exchange(replicas_count, rounds);
+                rounds++;
+                if (omp_get_wtime() > deadline) stop = 1;
+            }
+        }
+    }
+    return rounds;
+}
+
+// ================== Output ==================
+
+int check_schedule() {
+    static MachineTimeline timeline;
+    ScheduleCheck check;
+    ScheduleView instance = SCHEDULE_VIEW(ops_original, num_jobs, num_ops, num_machines);
+    if (validate_schedule(SCHEDULE_VIEW(ops, num_jobs, num_ops, num_machines), &instance, &timeline, &check) == SCHEDULE_OK)
+        return 1;
+    fprintf(stderr, "Invalid schedule: %s at job %d op %d\n", schedule_error_name(check.error), check.job, check.op);
+    return 0;
+}
+
+void write_output(const char *filename, int makespan, int replicas_count, long rounds, double elapsed) {
+    FILE *fp = fopen(filename, "w");
+    if (!fp) { perror("Error opening output file"); exit(1); }
+    fprintf(fp, "%d\n", makespan);
+    for (int j = 0; j < num_jobs; j++) {
+        for (int i = 0; i < num_ops; i++)
+            fprintf(fp, "%d ", ops[j][i].start);
+        fprintf(fp, "\n");
+    }
+
+    unsigned long long tried = 0, filtered = 0, accepted = 0;
+    for (int r = 0; r < replicas_count; r++) {
+        tried += replicas[r].tried;
+        filtered += replicas[r].filtered;
+        accepted += replicas[r].accepted;
+    }
+    fprintf(fp, "\n# Performance Analysis\n");
+    fprintf(fp, "Replicas: %d | Rounds: %ld | Runtime: %.3f seconds (%.0f moves/s)\n",
+            replicas_count, rounds, elapsed, tried / elapsed);
+    fprintf(fp, "Moves: %llu | rejected by estimate: %llu | accepted: %llu\n", tried, filtered, accepted);
+    fprintf(fp, "# slot temperature best exchange_rate\n");
+    for (int s = 0; s < replicas_count; s++)
+        fprintf(fp, "%2d %10.3f %6d %6.3f\n", s, temperature[s], replicas[replica_at[s]].best_makespan,
+                exchange_tried[s] ? (double)exchange_accepted[s] / exchange_tried[s] : 0.0);
+    fclose(fp);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s input.jss output.txt num_replicas seconds [tmin] [tmax] [seed]\n", argv[0]);
+        return 1;
+    }
+    read_input(argv[1]);
+    int replicas_count = atoi(argv[3]);
+    double seconds = atof(argv[4]);
+
+    // Default ladder: from one time unit to the mean operation duration
+    double mean = 0.0;
+    for (int j = 0; j < num_jobs; j++)
+        for (int i = 0; i < num_ops; i++) mean += ops[j][i].duration;
+    mean /= num_jobs * num_ops;
+    double tmin = argc > 5 ? atof(argv[5]) : 1.0;
+    double tmax = argc > 6 ? atof(argv[6]) : (mean > tmin ? mean : tmin);
+    if (argc > 7) seed = strtoull(argv[7], NULL, 10);
+    if (replicas_count < 1 || replicas_count > MAX_REPLICAS || seconds <= 0.0 || tmin <= 0.0 || tmax < tmin) {
+        fprintf(stderr, "Invalid parameters: replicas 1..%d, seconds > 0, 0 < tmin <= tmax\n", MAX_REPLICAS);
+        return 1;
+    }
+
+    double t0 = omp_get_wtime();
+    long rounds = parallel_tempering(replicas_count, tmin, tmax, seconds);
+    double elapsed = omp_get_wtime() - t0;
+
+    int best = 0;
+    for (int r = 1; r < replicas_count; r++)
+        if (replicas[r].best_makespan < replicas[best].best_makespan) best = r;
+    for (int j = 0; j < num_jobs; j++)
+        for (int i = 0; i < num_ops; i++)
+            ops[j][i] = replicas[best].best[j * num_ops + i];
+    int valid = check_schedule();
+
+    printf("Best makespan: %d (replica %d) | %ld exchange rounds in %.3f s\n",
+           replicas[best].best_makespan, best, rounds, elapsed);
+    write_output(argv[2], replicas[best].best_makespan, replicas_count, rounds, elapsed);
+    return valid ? 0 : 1;
+}
@@ -0,0 +1,428 @@
+/*
+    Job-Shop GRASP with path relinking (OpenMP iterations, shared elite pool)
+
+    Every iteration is independent:
+    1) construction: sequential_schedule() made greedy-randomized. At each
+       step the candidates are the next operation of every job; the greedy
+       value is the completion time it would get, and the next operation is
+       drawn from the restricted candidate list (RCL) of candidates within
+       min + alpha * (max - min).
+    2) local search: N5 descent on the disjunctive graph (as in mainV4.c).
+    3) path relinking: walk from the local optimum towards a random elite
+       solution, one position of the operation sequence at a time, keep the
+       best intermediate solution and run the local search on it.
+    4) elite update: the result enters the pool when it is better than the
+       worst elite solution and far enough from every elite solution (see
+       elite_slot()), so relinking keeps walking between different regions.
+
+    Solutions are operation sequences (job repetition: job j appears
+    num_ops times, its k-th occurrence is operation k). Any sequence is
+    feasible, so every step of a relinking path can be decoded; the sequence
+    of a local optimum is the topological order of its disjunctive graph.
+
+    Iterations run with schedule(dynamic) and draw their random numbers from
+    counter_rng.h with stream = iteration, so construction does not depend on
+    the thread that runs it. The elite pool is read at every relinking and
+    written only on improvements: a pthread rwlock lets the readers proceed
+    in parallel and the first check against the worst elite is done under
+    the read lock.
+
+    gcc -fopenmp -Wall -O2 -o mainGrasp mainGrasp.c ../schedule_check.c ../schedule_output.c ../disjunctive_graph.c -pthread
+
+    ./mainGrasp ../Matrizes/ta50.jss grasp_ta50.txt 8 200 [alpha] [seed]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <omp.h>
+#include "../jobshop.h"
+#include "../counter_rng.h"
+#include "../schedule_check.h"
+#include "../disjunctive_graph.h"
+
+#define MAX_JOBS     1000
+#define MAX_OPS      100
+#define MAX_MACHINES 100
+#define MAX_THREADS  64
+#define ELITE_SIZE   10
+#define ELITE_MIN_DISTANCE 0.1   // fraction of the operations whose start must differ from every elite solution
+#define DEFAULT_ALPHA 0.5
+
+// Counters inside the stream of an iteration
+#define CTR_CONSTRUCT  0
+#define CTR_GUIDE      ((uint64_t)1 << 40)
+
+int num_jobs, num_ops, num_machines, num_nodes;
+Operation ops_original[MAX_JOBS][MAX_OPS];   // instance as read, never modified
+Operation best_schedule[MAX_JOBS][MAX_OPS];
+
+typedef struct {
+    int makespan;
+    uint64_t hash;                   // of the start times: equal schedules, equal hash
+    int seq[JSS_MAX_OPERATIONS];     // job repetition sequence
+    int start[JSS_MAX_OPERATIONS];   // start time of node j * num_ops + i
+} Solution;
+
+// Large (about 7 MB): one per thread, static, touched only by its thread.
+typedef struct {
+    Operation sched[JSS_MAX_OPERATIONS];    // row stride num_ops
+    DisjunctiveGraph graph;
+    MachineTimeline timeline;
+    int moves[JSS_MAX_OPERATIONS][2];
+    int estimate[JSS_MAX_OPERATIONS];
+    int job_next[MAX_JOBS], job_ready[MAX_JOBS], machine_ready[MAX_MACHINES];
+    Solution current, guide, walk, walk_best;
+    unsigned long long swaps, relinks, relink_improved;
+} ThreadContext;
+
+ThreadContext contexts[MAX_THREADS];
+
+Solution elite[ELITE_SIZE];
+int elite_count = 0;
+int elite_worst = 0;
+pthread_rwlock_t elite_lock = PTHREAD_RWLOCK_INITIALIZER;
+unsigned long long elite_inserts = 0;
+int best_found = INT_MAX;   // best elite makespan, for the progress lines
+double start_time;
+
+uint64_t seed = 1;
+double alpha = DEFAULT_ALPHA;
+
+void read_input(const char *fn) {
+    FILE *fp = fopen(fn, "r");
+    if (!fp) { perror("open"); exit(1); }
+    if (fscanf(fp, "%d %d", &num_jobs, &num_machines) != 2 || num_jobs < 1 || num_jobs > MAX_JOBS ||
+        num_machines < 1 || num_machines > MAX_MACHINES || num_jobs * num_machines > JSS_MAX_OPERATIONS) {
+        fprintf(stderr, "Invalid instance header (jobs 1..%d, machines 1..%d)\n", MAX_JOBS, MAX_MACHINES);
+        exit(1);
+    }
+    num_ops = num_machines;
+    num_nodes = num_jobs * num_ops;
+    for (int j = 0; j < num_jobs; j++) {
+        for (int i = 0; i < num_ops; i++) {
+            if (fscanf(fp, "%d %d", &ops_original[j][i].machine, &ops_original[j][i].duration) != 2) {
+                fprintf(stderr, "Truncated instance at job %d op %d\n", j, i);
+                exit(1);
+            }
+        }
+    }
+    fclose(fp);
+}
+
+// ================== Construction ==================
+
+/*
+    sequential_schedule() with a restricted candidate list: instead of
+    taking the jobs in order, each step chooses among the next operations
+    of all jobs whose completion time is within alpha of the best one.
+*/
+void grasp_construct(ThreadContext *c, long iteration) {
+    for (int m = 0; m < num_machines; m++) c->machine_ready[m] = 0;
+    for (int j = 0; j < num_jobs; j++) c->job_next[j] = c->job_ready[j] = 0;
+
+    int rcl[MAX_JOBS];
+    for (int step = 0; step < num_nodes; step++) {
+        int lo = INT_MAX, hi = 0;
+        for (int j = 0; j < num_jobs; j++) {
+            if (c->job_next[j] == num_ops) continue;
+            const Operation *o = &ops_original[j][c->job_next[j]];
+            int ready = c->machine_ready[o->machine] > c->job_ready[j] ? c->machine_ready[o->machine] : c->job_ready[j];
+            int end = ready + o->duration;
+            if (end < lo) lo = end;
+            if (end > hi) hi = end;
+        }
+        int threshold = lo + (int)(alpha * (hi - lo));
+        int size = 0;
+        for (int j = 0; j < num_jobs; j++) {
+            if (c->job_next[j] == num_ops) continue;
+            const Operation *o = &ops_original[j][c->job_next[j]];
+            int ready = c->machine_ready[o->machine] > c->job_ready[j] ? c->machine_ready[o->machine] : c->job_ready[j];
+            if (ready + o->duration <= threshold) rcl[size++] = j;
+        }
+
+        int j = rcl[crng_range(seed, iteration, CTR_CONSTRUCT + step, 0, size - 1)];
+        int i = c->job_next[j]++;
+        Operation *o = &c->sched[j * num_ops + i];
+        *o = ops_original[j][i];
+        o->start = c->machine_ready[o->machine] > c->job_ready[j] ? c->machine_ready[o->machine] : c->job_ready[j];
+        o->end = o->start + o->duration;
+        c->job_ready[j] = c->machine_ready[o->machine] = o->end;
+        c->current.seq[step] = j;
+    }
+}
+
+// Semi-active schedule of a sequence into c->sched; returns the makespan.
+int decode(ThreadContext *c, const int *seq) {
+    int makespan = 0;
+    for (int m = 0; m < num_machines; m++) c->machine_ready[m] = 0;
+    for (int j = 0; j < num_jobs; j++) c->job_next[j] = c->job_ready[j] = 0;
+    for (int p = 0; p < num_nodes; p++) {
+        int j = seq[p], i = c->job_next[j]++;
+        Operation *o = &c->sched[j * num_ops + i];
+        *o = ops_original[j][i];
+        o->start = c->machine_ready[o->machine] > c->job_ready[j] ? c->machine_ready[o->machine] : c->job_ready[j];
+        o->end = o->start + o->duration;
+        c->job_ready[j] = c->machine_ready[o->machine] = o->end;
+        if (o->end > makespan) makespan = o->end;
+    }
+    return makespan;
+}
+
+// ================== Local search ==================
+
+/*
+    N5 descent on c->sched (same move rule as mainV4.c): rank the critical
+    block swaps by their O(1) estimate, keep the first one that really
+    lowers the makespan, stop when none does. The result is written back to
+    s as the graph's topological order.
+*/
+void local_search(ThreadContext *c, Solution *s) {
+    DisjunctiveGraph *g = &c->graph;
+    ScheduleView v = { c->sched, num_ops, num_jobs, num_ops, num_machines };
+    if (dg_build(g, v, &c->timeline) < 0) {
+        s->makespan = INT_MAX;
+        return;
+    }
+
+    int improved = 1;
+    while (improved) {
+        improved = 0;
+        int n = dg_critical_moves(g, c->moves, JSS_MAX_OPERATIONS);
+        for (int k = 0; k < n; k++)
+            c->estimate[k] = dg_swap_estimate(g, c->moves[k][0], c->moves[k][1]);
+
+        while (!improved) {
+            int best = -1;
+            for (int k = 0; k < n; k++)
+                if (c->estimate[k] < g->makespan && (best < 0 || c->estimate[k] < c->estimate[best])) best = k;
+            if (best < 0) break;
+            c->estimate[best] = g->makespan;
+
+            int u = c->moves[best][0], w = c->moves[best][1];
+            int before = g->makespan;
+            int after = dg_swap(g, u, w);
+            if (after >= 0 && after < before) improved = 1;
+            else if (after >= 0) dg_swap(g, w, u);
+            c->swaps++;
+        }
+    }
+
+    s->makespan = g->makespan;
+    s->hash = 1469598103934665603ULL;
+    for (int p = 0; p < num_nodes; p++) {
+        s->seq[p] = g->topo[p] / num_ops;
+        s->start[p] = g->head[p];
+        s->hash = (s->hash ^ (uint64_t)g->head[p]) * 1099511628211ULL;
+    }
+}
+
+// ================== Elite pool ==================
+
+// Copies a random elite solution into c->guide; 0 when the pool is empty.
+int elite_pick(ThreadContext *c, long iteration) {
+    int found = 0;
+    pthread_rwlock_rdlock(&elite_lock);
+    if (elite_count > 0) {
+        int e = crng_range(seed, iteration, CTR_GUIDE, 0, elite_count - 1);
+        c->guide.makespan = elite[e].makespan;
+        c->guide.hash = elite[e].hash;
+        memcpy(c->guide.seq, elite[e].seq, sizeof(int) * num_nodes);
+        found = 1;
+    }
+    pthread_rwlock_unlock(&elite_lock);
+    return found;
+}
+
+// Operations that start at different times in a and b.
+static int distance(const Solution *a, const Solution *b) {
+    int d = 0;
+    for (int k = 0; k < num_nodes; k++) d += a->start[k] != b->start[k];
+    return d;
+}
+
+/*
+    Slot that s may take, -1 to reject it. s must differ from every elite
+    solution in at least ELITE_MIN_DISTANCE of the start times (a new best
+    only has to differ at all). In a full pool it replaces the most similar
+    solution among those worse than it: a cluster of near-copies of one
+    local optimum shrinks instead of filling the pool.
+*/
+static int elite_slot(const Solution *s) {
+    int needed = s->makespan < best_found ? 1 : (int)(ELITE_MIN_DISTANCE * num_nodes);
+    if (needed < 1) needed = 1;
+    int closest = -1, closest_distance = INT_MAX;
+    for (int e = 0; e < elite_count; e++) {
+        int d = distance(s, &elite[e]);
+        if (d < needed) return -1;
+        if (elite[e].makespan > s->makespan && d < closest_distance) {
+            closest = e;
+            closest_distance = d;
+        }
+    }
+    return elite_count < ELITE_SIZE ? elite_count : closest;
+}
+
+void elite_offer(const Solution *s) {
+    if (s->makespan == INT_MAX) return;
+
+    // Most offers are rejected: decide that under the shared lock.
+    pthread_rwlock_rdlock(&elite_lock);
+    int admit = (elite_count < ELITE_SIZE || s->makespan < elite[elite_worst].makespan) && elite_slot(s) >= 0;
+    pthread_rwlock_unlock(&elite_lock);
+    if (!admit) return;
+
+    int improved = 0;
+    pthread_rwlock_wrlock(&elite_lock);
+    int slot = elite_slot(s);   // the pool may have changed in between
+    if (slot >= 0) {
+        if (slot == elite_count) elite_count++;
+        elite[slot].makespan = s->makespan;
+        elite[slot].hash = s->hash;
+        memcpy(elite[slot].seq, s->seq, sizeof(int) * num_nodes);
+        memcpy(elite[slot].start, s->start, sizeof(int) * num_nodes);
+        elite_worst = 0;
+        for (int e = 1; e < elite_count; e++)
+            if (elite[e].makespan > elite[elite_worst].makespan) elite_worst = e;
+        elite_inserts++;
+        if (s->makespan < best_found) {
+            best_found = s->makespan;
+            improved = 1;
+        }
+    }
+    pthread_rwlock_unlock(&elite_lock);
+    if (improved) {   // printed outside the lock: stdout may block
+        printf("[Incumbent] %d | Elapsed=%.2fs\n", s->makespan, omp_get_wtime() - start_time);
+        fflush(stdout);
+    }
+}
+
+// ================== Path relinking ==================
+
+/*
+    Forward relinking from c->current to c->guide: position p of the walk
+    is fixed to guide[p] by swapping in the next occurrence of that job.
+    Every intermediate sequence is decoded; the best strictly intermediate
+    one (neither endpoint) goes through the local search.
+*/
+void path_relink(ThreadContext *c) {
+    memcpy(c->walk.seq, c->current.seq, sizeof(int) * num_nodes);
+    c->walk_best.makespan = INT_MAX;
+    int best_step = -1, steps = 0;
+
+    for (int p = 0; p < num_nodes; p++) {
+        if (c->walk.seq[p] == c->guide.seq[p]) continue;
+        int q = p + 1;
+        while (c->walk.seq[q] != c->guide.seq[p]) q++;
+        c->walk.seq[q] = c->walk.seq[p];
+        c->walk.seq[p] = c->guide.seq[p];
+        steps++;
+
+        if (memcmp(c->walk.seq + p, c->guide.seq + p, sizeof(int) * (num_nodes - p)) == 0) break;
+        int makespan = decode(c, c->walk.seq);
+        if (makespan < c->walk_best.makespan) {
+            c->walk_best.makespan = makespan;
+            memcpy(c->walk_best.seq, c->walk.seq, sizeof(int) * num_nodes);
+            best_step = steps;
+        }
+    }
+    if (best_step < 0) return;
+
+    c->relinks++;
+    decode(c, c->walk_best.seq);
+    local_search(c, &c->walk_best);
+    if (c->walk_best.makespan < c->current.makespan && c->walk_best.makespan < c->guide.makespan)
+        c->relink_improved++;
+    elite_offer(&c->walk_best);
+}
+
+void grasp_iteration(ThreadContext *c, long iteration) {
+    grasp_construct(c, iteration);
+    local_search(c, &c->current);
+    if (elite_pick(c, iteration) && c->guide.hash != c->current.hash)
+        path_relink(c);
+    elite_offer(&c->current);
+}
+
+// ================== Output ==================
+
+int best_elite() {
+    int best = 0;
+    for (int e = 1; e < elite_count; e++)
+        if (elite[e].makespan < elite[best].makespan) best = e;
+    return best;
+}
+
+int check_schedule() {
+    static MachineTimeline timeline;
+    ScheduleCheck check;
+    ScheduleView instance = SCHEDULE_VIEW(ops_original, num_jobs, num_ops, num_machines);
+    if (validate_schedule(SCHEDULE_VIEW(best_schedule, num_jobs, num_ops, num_machines), &instance, &timeline, &check) == SCHEDULE_OK)
+        return 1;
+    fprintf(stderr, "Invalid schedule: %s at job %d op %d\n", schedule_error_name(check.error), check.job, check.op);
+    return 0;
+}
+
+void write_output(const char *filename, int makespan, int threads, long iterations, double elapsed) {
+    FILE *fp = fopen(filename, "w");
+    if (!fp) { perror("Error opening output file"); exit(1); }
+    fprintf(fp, "%d\n", makespan);
+    for (int j = 0; j < num_jobs; j++) {
+        for (int i = 0; i < num_ops; i++)
+            fprintf(fp, "%d ", best_schedule[j][i].start);
+        fprintf(fp, "\n");
+    }
+
+    unsigned long long swaps = 0, relinks = 0, relink_improved = 0;
+    for (int t = 0; t < threads; t++) {
+        swaps += contexts[t].swaps;
+        relinks += contexts[t].relinks;
+        relink_improved += contexts[t].relink_improved;
+    }
+    fprintf(fp, "\n# Performance Analysis\n");
+    fprintf(fp, "Threads: %d | Iterations: %ld | alpha: %.2f | seed: %llu\n",
+            threads, iterations, alpha, (unsigned long long)seed);
+    fprintf(fp, "Runtime: %.6f seconds (%.1f iterations/s)\n", elapsed, iterations / elapsed);
+    fprintf(fp, "Swaps tried: %llu | Relinks: %llu (better than both ends: %llu) | Elite inserts: %llu\n",
+            swaps, relinks, relink_improved, elite_inserts);
+    fclose(fp);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s input.jss output.txt num_threads iterations [alpha] [seed]\n", argv[0]);
+        return 1;
+    }
+    read_input(argv[1]);
+    int threads = atoi(argv[3]);
+    long iterations = atol(argv[4]);
+    if (argc > 5) alpha = atof(argv[5]);
+    if (argc > 6) seed = strtoull(argv[6], NULL, 10);
+    if (threads < 1 || threads > MAX_THREADS || iterations < 1 || alpha < 0.0 || alpha > 1.0) {
+        fprintf(stderr, "Invalid parameters: threads 1..%d, iterations >= 1, alpha in [0, 1]\n", MAX_THREADS);
+        return 1;
+    }
+
+    double t0 = omp_get_wtime();
+    start_time = t0;
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(threads)
+    for (long it = 0; it < iterations; it++)
+        grasp_iteration(&contexts[omp_get_thread_num()], it);
+    double elapsed = omp_get_wtime() - t0;
+
+    // Best elite back to an Operation table, checked against the instance
+    ThreadContext *c = &contexts[0];
+    int makespan = decode(c, elite[best_elite()].seq);
+    for (int j = 0; j < num_jobs; j++)
+        for (int i = 0; i < num_ops; i++)
+            best_schedule[j][i] = c->sched[j * num_ops + i];
+    int valid = check_schedule();
+
+    printf("Best makespan: %d | elite: %d..%d | %.3f s with %d threads\n",
+           makespan, elite[best_elite()].makespan, elite[elite_worst].makespan, elapsed, threads);
+    write_output(argv[2], makespan, threads, iterations, elapsed);
+    return valid ? 0 : 1;
+}
@@ -8,25 +8,31 @@
        - No two operations on the same machine at the same time
        - Operations within a job respect their sequence: each starts after the previous ends
        - Overall schedule length (makespan) is minimized relative to sequential baseline
+
+    gcc -fopenmp -Wall -O2 -o mainV3Optimized mainV3Optimized.c ../schedule_output.c ../schedule_check.c ../shape_kernels.c
+    ./mainV3Optimized ../Matrizes/ta80.jss out.txt 4 10 [--gantt[=N]] [--binary=FILE] [--kernel=generic]
+
+    With 1 thread the schedule comes from a shape-specialized kernel when the
+    instance is 6x6, 10x10, 15x15, 20x20 or 50x15 (../shape_kernels.h);
+    --kernel=generic forces the run-time-bounds build for comparison.
 */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <omp.h>
 #include <string.h>
+#include "../jobshop.h"
+#include "../schedule_output.h"
+#include "../schedule_check.h"
+#include "../cache_layout.h"
+#include "../shape_kernels.h"
 
-#define MAX_JOBS 100     // no dynamic allocation (Constraint 1)
+#define MAX_JOBS 1000    // no dynamic allocation (Constraint 1); fits 1000x50 stress instances
 #define MAX_OPS 100      // assumes num_ops == num_machines
 #define MAX_MACHINES 100
 #define MAX_REPEATS 100
 
-// Structure for an operation (no pointers used - Constraint 1)
-typedef struct {
-    int machine;   // machine index
-    int duration;  // processing time
-    int start;     // start time computed
-    int end;       // end time computed
-} Operation;
+// Operation {machine, duration, start, end} comes from jobshop.h (no pointers used - Constraint 1)
 
 // Static storage for all jobs and operations (Constraint 1)
 int num_jobs;
@@ -35,10 +41,14 @@ int num_machines;
 Operation ops[MAX_JOBS][MAX_OPS];
 Operation ops_backup[MAX_JOBS][MAX_OPS];
 
-// Shared arrays
-int machine_available[MAX_MACHINES];  // tracks when each machine becomes free
-int job_available[MAX_JOBS];          // sequential: tracks job readiness
-omp_lock_t machine_lock[MAX_MACHINES]; // one lock per machine (Constraint 3)
+// Shared machine state: a machine's availability and its lock share one
+// cache line, and no other machine uses that line (no false sharing)
+typedef struct {
+    CACHE_ALIGNED int available;  // tracks when the machine becomes free
+    omp_lock_t lock;              // one lock per machine (Constraint 3)
+} MachineSlot;
+MachineSlot machines[MAX_MACHINES];
+ShapeKernels kernels;             // sequential: list schedule for the instance shape
 
 // ================== Input/Output ==================
 void read_input(const char *filename) {
@@ -70,120 +80,52 @@ void reset_data() {
     }
 }
 
-void print_gantt_chart(FILE *fp) {
-    const int block_size = 5;  // Compress time axis
-    fprintf(fp, "\n# Gantt Chart (Compressed: 1 char = %d time units)\n", block_size);
-
-    // Calculate makespan
-    int makespan = 0;
-    for (int j = 0; j < num_jobs; j++) {
-        for (int i = 0; i < num_ops; i++) {
-            if (ops[j][i].end > makespan)
-                makespan = ops[j][i].end;
-        }
-    }
-
-    int blocks = (makespan + block_size - 1) / block_size;  // total columns
-
-    // Gantt lines by machine
-    for (int m = 0; m < num_machines; m++) {
-        fprintf(fp, "Machine %2d |", m);
-        for (int b = 0; b < blocks; b++) {
-            int t_start = b * block_size;
-            int t_end = t_start + block_size;
-            int printed = 0;
-
-            for (int j = 0; j < num_jobs; j++) {
-                for (int i = 0; i < num_ops; i++) {
-                    if (ops[j][i].machine == m &&
-                        ops[j][i].start < t_end &&
-                        ops[j][i].end > t_start) {
-                        fprintf(fp, "J%d", j);  // mark job
-                        printed = 1;
-                        break;
-                    }
-                }
-                if (printed) break;
-            }
-            if (!printed) fprintf(fp, "  ");
-        }
-        fprintf(fp, "|\n");
-    }
-
-    // Time scale
-    fprintf(fp, "\nTime       ");
-    for (int b = 0; b < blocks; b++) {
-        int label = b * block_size;
-        if (label < 10) fprintf(fp, "  %d", label);
-        else if (label < 100) fprintf(fp, " %d", label);
-        else fprintf(fp, "%d", label);  // space-adjusted
-    }
-    // Add the exact makespan as final tick
-    fprintf(fp, " %d\n", makespan);
-}
-
-
-
 // ================== Output ==================
-void write_output(const char *filename, double avg_time, int repeats) {
+void write_output(const char *filename, double avg_time, int repeats,
+                  int gantt_resolution, const char *binary_filename) {
     FILE *fp = fopen(filename, "w");
     if (!fp) { perror("Error opening output file"); exit(1); }
 
-    // Compute makespan (max end time)
-    int makespan = 0;
-    for (int j = 0; j < num_jobs; j++) {
-        for (int i = 0; i < num_ops; i++) {
-            if (ops[j][i].end > makespan)
-                makespan = ops[j][i].end;
-        }
+    // Timeline built once; it also gives the makespan (max end time)
+    static OutputWriter w;
+    static MachineTimeline timeline;
+    ScheduleView view = SCHEDULE_VIEW(ops, num_jobs, num_ops, num_machines);
+    if (build_timeline(&timeline, view) != 0) {
+        fprintf(stderr, "Schedule too large for output timeline\n");
+        exit(1);
     }
+    writer_init(&w, fp);
 
     // Output makespan and operation start times
-    fprintf(fp, "%d\n", makespan);
-    for (int j = 0; j < num_jobs; j++) {
-        for (int i = 0; i < num_ops; i++) {
-            fprintf(fp, "%d ", ops[j][i].start);
-        }
-        fprintf(fp, "\n");
-    }
-    // Print Gantt chart
-    print_gantt_chart(fp);
-
+    writer_printf(&w, "%d\n", timeline.makespan);
+    write_schedule_text(&w, view);
+    // Gantt chart only on request (separate mode, configurable resolution)
+    if (gantt_resolution > 0) write_gantt_chart(&w, &timeline, gantt_resolution);
 
     // Performance section
-    fprintf(fp, "\n# Performance Analysis\n");
-    fprintf(fp, "Average runtime over %d repetitions: %.6f seconds\n", repeats, avg_time);
+    writer_puts(&w, "\n# Performance Analysis\n");
+    writer_printf(&w, "Average runtime over %d repetitions: %.6f seconds\n", repeats, avg_time);
+    writer_printf(&w, "Sequential kernel: %s\n", kernels.name);
+    writer_flush(&w);
     fclose(fp);
+
+    if (binary_filename && write_schedule_binary(binary_filename, view, timeline.makespan) != 0)
+        perror("Error writing binary schedule");
 }
 
 // ================== Sequential Scheduling ==================
 void sequential_schedule() {
-    // Initialize availability
-    for (int m = 0; m < num_machines; m++) machine_available[m] = 0;
-    for (int j = 0; j < num_jobs; j++) job_available[j] = 0;
-
-    // Assign start/end times respecting both machine and job constraints (Constraint 4)
-    for (int j = 0; j < num_jobs; j++) {
-        for (int i = 0; i < num_ops; i++) {
-            int m = ops[j][i].machine;
-            // Wait for both machine and job readiness
-            int ready = (machine_available[m] > job_available[j]
-                         ? machine_available[m] : job_available[j]);
-            ops[j][i].start = ready;
-            ops[j][i].end = ready + ops[j][i].duration;
-            // Update when job and machine become free next
-            job_available[j] = ops[j][i].end;
-            machine_available[m] = ops[j][i].end;  // prevents two ops on same machine (Constraint 4)
-        }
-    }
+    // Jobs in order, each op at max(machine ready, job ready) (Constraint 4);
+    // the kernel keeps machine and job readiness in locals
+    kernels.list_schedule(&ops[0][0], MAX_OPS, num_jobs, num_ops);
 }
 
 // ================== Parallel Scheduling with OpenMP ==================
 void parallel_schedule(int num_threads) {
     // Reset machine availability and initialize locks
     for (int m = 0; m < num_machines; m++) {
-        machine_available[m] = 0;
-        omp_init_lock(&machine_lock[m]); // one lock per machine (Constraint 3)
+        machines[m].available = 0;
+        omp_init_lock(&machines[m].lock); // one lock per machine (Constraint 3)
     }
 
     // Each job is processed in parallel; job order ensures op sequence
@@ -196,17 +138,17 @@ void parallel_schedule(int num_threads) {
             int d = ops[j][i].duration;
 
             // RACE CONDITION: without this lock multiple threads could
-            // read/update machine_available[m] at the same time
-            omp_set_lock(&machine_lock[m]); // lock machine (Constraint 3)
+            // read/update machines[m].available at the same time
+            omp_set_lock(&machines[m].lock); // lock machine (Constraint 3)
 
             // Compute earliest start based on both machine & job readiness
-            int ready = (machine_available[m] > local_available
-                         ? machine_available[m] : local_available);
+            int ready = (machines[m].available > local_available
+                         ? machines[m].available : local_available);
             int start = ready;
             int end = start + d;
 
-            machine_available[m] = end; // mark machine busy until 'end'
-            omp_unset_lock(&machine_lock[m]); // unlock machine
+            machines[m].available = end; // mark machine busy until 'end'
+            omp_unset_lock(&machines[m].lock); // unlock machine
 
             // Record schedule
             ops[j][i].start = start; // solution: when op j,i starts
@@ -217,7 +159,7 @@ void parallel_schedule(int num_threads) {
 
     // Destroy locks
     for (int m = 0; m < num_machines; m++) {
-        omp_destroy_lock(&machine_lock[m]);
+        omp_destroy_lock(&machines[m].lock);
     }
 }
 
@@ -240,7 +182,7 @@ double measure_execution(int threads, int repeats) {
 // ================== Main ==================
 int main(int argc, char *argv[]) {
     if (argc < 5) {
-        fprintf(stderr, "Usage: %s input.jss output.txt num_threads num_repeats\n", argv[0]);
+        fprintf(stderr, "Usage: %s input.jss output.txt num_threads num_repeats [--gantt[=N]] [--binary=FILE] [--kernel=generic]\n", argv[0]);
         return 1;
     }
 
@@ -252,7 +194,21 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
+    int gantt_resolution = 0;
+    const char *binary_filename = NULL;
+    kernels = shape_kernels_select(num_jobs, num_machines);
+    for (int a = 5; a < argc; a++) {
+        if (strcmp(argv[a], "--gantt") == 0) gantt_resolution = 5;
+        else if (strncmp(argv[a], "--gantt=", 8) == 0) gantt_resolution = atoi(argv[a] + 8);
+        else if (strncmp(argv[a], "--binary=", 9) == 0) binary_filename = argv[a] + 9;
+        else if (strcmp(argv[a], "--kernel=generic") == 0) kernels = shape_kernels_generic();
+        else { fprintf(stderr, "Unknown option: %s\n", argv[a]); return 1; }
+    }
+
     double avg_time = measure_execution(threads, repeats);
-    write_output(argv[2], avg_time, repeats);
+    // The lock-based parallel_schedule() must still respect every constraint
+    assert_valid_schedule(SCHEDULE_VIEW(ops, num_jobs, num_ops, num_machines),
+                          &SCHEDULE_VIEW(ops_backup, num_jobs, num_ops, num_machines), "measure_execution");
+    write_output(argv[2], avg_time, repeats, gantt_resolution, binary_filename);
     return 0;
 }
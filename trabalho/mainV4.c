@@ -8,6 +8,8 @@
        - No two operations on the same machine at the same time
        - Operations within a job respect their sequence: each starts after the previous ends
        - Overall schedule length (makespan) is minimized relative to sequential baseline
+
+    gcc -fopenmp -Wall -O2 -o mainV4 mainV4.c ../schedule_check.c ../schedule_output.c ../disjunctive_graph.c
 */
 
 #include <stdio.h>
@@ -15,22 +17,20 @@
 #include <omp.h>
 #include <string.h>
 #include <limits.h>
+#include "../jobshop.h"
+#include "../schedule_check.h"
+#include "../disjunctive_graph.h"
 
-#define MAX_JOBS     100
+#define MAX_JOBS     1000   // up to the 1000x50 generated stress instances
 #define MAX_OPS      100
 #define MAX_MACHINES 100
 #define MAX_REPEATS  100
-
-typedef struct {
-    int machine;
-    int duration;
-    int start;
-    int end;
-} Operation;
+#define PARALLEL_ESTIMATES 2048   // candidate moves before the estimates are split over threads
 
 int num_jobs, num_ops, num_machines;
 Operation ops[MAX_JOBS][MAX_OPS];
 Operation ops_backup[MAX_JOBS][MAX_OPS];
+Operation ops_original[MAX_JOBS][MAX_OPS];   // instance as read, never modified
 int machine_available[MAX_MACHINES];
 int job_available[MAX_JOBS];
 omp_lock_t machine_lock[MAX_MACHINES];
@@ -43,6 +43,7 @@ void read_input(const char *fn) {
     for (int j = 0; j < num_jobs; j++) {
         for (int i = 0; i < num_ops; i++) {
             fscanf(fp, "%d %d", &ops_backup[j][i].machine, &ops_backup[j][i].duration);
+            ops_original[j][i] = ops_backup[j][i];
         }
     }
     fclose(fp);
@@ -85,42 +86,69 @@ int compute_makespan() {
     return makespan;
 }
 
-void shifting_bottleneck() {
+/*
+    Improvement phase on the disjunctive graph: instead of replaying the whole
+    schedule for every candidate, moves are adjacent swaps inside critical
+    blocks (N5), ranked by their O(1) estimate and applied incrementally.
+    The first move that really lowers the makespan is kept; the search stops
+    when no candidate improves. The estimates only read the graph: long
+    candidate lists (large instances) are estimated by num_threads threads.
+*/
+DisjunctiveGraph graph;
+MachineTimeline graph_timeline;
+int candidate_moves[JSS_MAX_OPERATIONS][2];
+int move_estimate[JSS_MAX_OPERATIONS];
+unsigned long long moves_estimated = 0, moves_applied = 0;
+double estimate_seconds = 0.0, apply_seconds = 0.0;
+
+void shifting_bottleneck(int threads) {
+    reset_data();
+    sequential_schedule();
+    if (dg_build(&graph, SCHEDULE_VIEW(ops, num_jobs, num_ops, num_machines), &graph_timeline) < 0)
+        return;
+
     int improved = 1;
     while (improved) {
         improved = 0;
-        for (int j1 = 0; j1 < num_jobs - 1; j1++) {
-            for (int j2 = j1 + 1; j2 < num_jobs; j2++) {
-                for (int m = 0; m < num_machines; m++) {
-                    reset_data();
-                    // swap job j1 and j2 at all operations on machine m
-                    for (int i = 0; i < num_ops; i++) {
-                        if (ops[j1][i].machine == m && ops[j2][i].machine == m) {
-                            Operation temp = ops_backup[j1][i];
-                            ops_backup[j1][i] = ops_backup[j2][i];
-                            ops_backup[j2][i] = temp;
-                        }
-                    }
-                    sequential_schedule();
-                    int new_makespan = compute_makespan();
-                    if (new_makespan < compute_makespan()) {
-                        improved = 1;
-                    } else {
-                        // revert the swap
-                        for (int i = 0; i < num_ops; i++) {
-                            if (ops_backup[j1][i].machine == m && ops_backup[j2][i].machine == m) {
-                                Operation temp = ops_backup[j1][i];
-                                ops_backup[j1][i] = ops_backup[j2][i];
-                                ops_backup[j2][i] = temp;
-                            }
-                        }
-                    }
-                }
-            }
+        int n = dg_critical_moves(&graph, candidate_moves, JSS_MAX_OPERATIONS);
+
+        double t0 = omp_get_wtime();
+        #pragma omp parallel for num_threads(threads) if (threads > 1 && n >= PARALLEL_ESTIMATES)
+        for (int c = 0; c < n; c++)
+            move_estimate[c] = dg_swap_estimate(&graph, candidate_moves[c][0], candidate_moves[c][1]);
+        estimate_seconds += omp_get_wtime() - t0;
+        moves_estimated += n;
+
+        // Try candidates from the best estimate up; keep the first real improvement
+        while (!improved) {
+            int best = -1;
+            for (int c = 0; c < n; c++)
+                if (move_estimate[c] < graph.makespan && (best < 0 || move_estimate[c] < move_estimate[best])) best = c;
+            if (best < 0) break;
+            move_estimate[best] = graph.makespan;   // not tried again
+
+            int u = candidate_moves[best][0], v = candidate_moves[best][1];
+            int before = graph.makespan;
+            double t1 = omp_get_wtime();
+            int after = dg_swap(&graph, u, v);
+            if (after >= 0 && after < before) improved = 1;
+            else if (after >= 0) dg_swap(&graph, v, u);   // revert
+            apply_seconds += omp_get_wtime() - t1;
+            moves_applied++;
         }
     }
-    reset_data();
-    sequential_schedule();
+    dg_write_schedule(&graph, &ops[0][0], MAX_OPS);
+}
+
+// Final schedule checked against the instance as read
+int check_schedule() {
+    static MachineTimeline timeline;
+    ScheduleCheck check;
+    ScheduleView instance = SCHEDULE_VIEW(ops_original, num_jobs, num_ops, num_machines);
+    if (validate_schedule(SCHEDULE_VIEW(ops, num_jobs, num_ops, num_machines), &instance, &timeline, &check) == SCHEDULE_OK)
+        return 1;
+    fprintf(stderr, "Invalid schedule: %s at job %d op %d\n", schedule_error_name(check.error), check.job, check.op);
+    return 0;
 }
 
 void print_gantt_chart(FILE *fp) {
@@ -173,6 +201,10 @@ void write_output(const char *filename, double avg_time, int repeats) {
     print_gantt_chart(fp);
     fprintf(fp, "\n# Performance Analysis\n");
     fprintf(fp, "Average runtime over %d repetitions: %.6f seconds\n", repeats, avg_time);
+    if (moves_estimated > 0)
+        fprintf(fp, "Move estimates: %llu (%.3f us each) | Applied swaps: %llu (%.3f us each)\n",
+                moves_estimated, 1e6 * estimate_seconds / moves_estimated,
+                moves_applied, moves_applied ? 1e6 * apply_seconds / moves_applied : 0.0);
     fclose(fp);
 }
 
@@ -181,7 +213,7 @@ double measure_execution(int threads, int repeats) {
     for (int r = 0; r < repeats; r++) {
         reset_data();
         double t0 = omp_get_wtime();
-        shifting_bottleneck();
+        shifting_bottleneck(threads);
         double t1 = omp_get_wtime();
         total_time += (t1 - t0);
     }
@@ -201,6 +233,7 @@ int main(int argc, char *argv[]) {
         return 1;
     }
     double avg_time = measure_execution(threads, repeats);
+    int valid = check_schedule();
     write_output(argv[2], avg_time, repeats);
-    return 0;
+    return valid ? 0 : 1;
 }
@@ -1,131 +1,161 @@
+/*
+    Flexible Job-Shop em OpenMP: pesquisa de reatribuições de uma alternativa
+
+    # clang -Xpreprocessor -fopenmp -I$(brew --prefix libomp)/include -L$(brew --prefix libomp)/lib -lomp paralelOMP.c fjsp.c -o paralelOMP
+    # gcc -fopenmp -Wall -O2 paralelOMP.c fjsp.c -o paralelOMP
+    # ./paralelOMP [semente]
+
+    Cada movimento muda a alternativa de uma operação. Em vez de chamar
+    compute_makespan() sobre as NUM_JOBS*MAX_OPS operações por movimento, o
+    FjspReplay (fjsp.c) guarda o perfil das máquinas antes de cada job e só
+    repete o sufixo afetado. Cada thread guarda o seu melhor movimento e a
+    redução é feita uma vez por varrimento (sem lock por avaliação).
+*/
+
+// TODO: professor não quer apontadores, nao quer estruturas dinamicas
+// TODO: Mencionar no codigo onde estão as condições de corrida para depois conseguir explicar
+// TODO: uma ideia para fazer Paralelo: Para cada Maquina Usar o mutex, então assim so uma thread pode aceder a essa maquina de cada vez
+// TODO: regras: não pode haver duas operações a correr na mesma máquina ao mesmo tempo / a operacao a seguir so pode começar quando a anterior acabar / tem de dar sempre menos que o makespan
+// TODO: brench and bound ou Shitf and Bottleneck
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <omp.h>
 #include <time.h>
+#include "fjsp.h"
 
+#ifndef NUM_JOBS
 #define NUM_JOBS 100
+#endif
 #define MAX_OPS  100
 #define NUM_MACHINES 10
-#define NUM_THREADS 6  
-
-#TODO: professor não quer apontadores, nao quer estruturas dinamicas 
-#TODO: Mencionar no codigo onde estão as condições de corrida para depois conseguir explicar 
-#TODO: uma ideia para fazer Paralelo: Para cada Maquina Usar o mutex, então assim so uma thread pode aceder a essa maquina de cada vez
-#TODO: regras: não pode haver duas operações a correr na mesma máquina ao mesmo tempo / a operacao a seguir so pode começar quando a anterior acabar / tem de dar sempre menos que o makespan
-
-#TODO: brench and bound ou Shitf and Bottleneck
-
-#TODO: Usar esta estrutura de dados para representar o problema:
-# operacao tem de ter Maquina[start,Duracação,End]
-#       operacao 1  | Operacoes 2 |
-#job 1   | Maquina  | Maquina    |
-#job 2   | Maquina  | Maquina    |
-#job 3   | Maquina  | Maquina    |
-#job 4   | Maquina  | Maquina    |
-
-
-
-int compute_makespan(int assignment[NUM_JOBS][MAX_OPS]) {
-    int machine_avail[NUM_MACHINES] = {0};
-    int job_finish[NUM_JOBS] = {0};
+#define NUM_THREADS 6
+#define MAX_THREADS 64
+#define MAX_SWEEPS 50    // limite de varrimentos da descida
+
+FjspInstance instance;
+int assignment[FJSP_MAX_JOBS][FJSP_MAX_OPS];
+int best_makespan = INT_MAX;
+FjspReplay replays[MAX_THREADS];     // uma cópia do estado por thread
+unsigned long long evaluations = 0;
+
+// Melhor movimento de cada thread, numa linha de cache própria
+typedef struct {
+    _Alignas(64) int makespan;
+    int job, op, alt;
+} LocalBest;
+LocalBest local_best[MAX_THREADS];
+
+// Avaliação completa (referência): repete todos os jobs pela ordem.
+int compute_makespan(int assign[FJSP_MAX_JOBS][FJSP_MAX_OPS]) {
+    int machine_avail[FJSP_MAX_MACHINES] = {0};
+    int makespan = 0;
 
-    for (int j = 0; j < NUM_JOBS; j++) {
+    for (int j = 0; j < instance.num_jobs; j++) {
         int time = 0;
-        for (int o = 0; o < jobs[j].num_ops; o++) {
-            int selected_alt = assignment[j][o];
-            if (selected_alt < 0 || selected_alt >= jobs[j].ops[o].num_alts) continue;  
-            Alternative alt = jobs[j].ops[o].alts[selected_alt];
-
+        for (int o = 0; o < instance.jobs[j].num_ops; o++) {
+            Alternative alt = instance.jobs[j].ops[o].alts[assign[j][o]];
             int start = (machine_avail[alt.machine] > time) ? machine_avail[alt.machine] : time;
             int finish = start + alt.proc_time;
             machine_avail[alt.machine] = finish;
             time = finish;
         }
-        job_finish[j] = time;
-    }
-
-    int makespan = 0;
-    for (int j = 0; j < NUM_JOBS; j++) {
-        if (job_finish[j] > makespan)
-            makespan = job_finish[j];
+        if (time > makespan) makespan = time;
     }
     return makespan;
 }
 
+/*
+    Descida: em cada varrimento as threads avaliam em paralelo todas as
+    mudanças de uma alternativa sobre a atribuição atual; o melhor movimento
+    global é aplicado a todas as cópias e repete-se enquanto houver melhoria
+    (no máximo MAX_SWEEPS varrimentos).
+*/
 void solve_parallel() {
+    fjsp_replay_init(&instance, &replays[0], assignment);
+    best_makespan = replays[0].makespan;
+
     #pragma omp parallel num_threads(NUM_THREADS)
     {
-        int (*local_assignment)[MAX_OPS] = malloc(NUM_JOBS * sizeof(*local_assignment));  
-        if (!local_assignment) {
-            printf("Erro ao alocar memória\n");
-            exit(1);
-        }
-
-        #pragma omp for
-        for (int i = 0; i < NUM_JOBS; i++) {
-            for (int j = 0; j < jobs[i].num_ops; j++) {
-                for (int k = 0; k < jobs[i].ops[j].num_alts; k++) {
-                    local_assignment[i][j] = k;
-                    int makespan = compute_makespan(local_assignment);
-
-                    omp_set_lock(&best_lock);
-                    if (makespan < best_makespan) {
-                        best_makespan = makespan;
+        int tid = omp_get_thread_num();
+        FjspReplay *r = &replays[tid];
+        if (tid != 0) fjsp_replay_init(&instance, r, assignment);
+
+        for (int sweep = 0; sweep < MAX_SWEEPS; sweep++) {
+            LocalBest *lb = &local_best[tid];
+            lb->makespan = r->makespan;
+            lb->job = -1;
+            unsigned long long local_evaluations = 0;
+
+            #pragma omp for schedule(dynamic, 1)
+            for (int i = 0; i < instance.num_jobs; i++) {
+                for (int j = 0; j < instance.jobs[i].num_ops; j++) {
+                    for (int k = 0; k < instance.jobs[i].ops[j].num_alts; k++) {
+                        if (k == r->assignment[i][j]) continue;
+                        int makespan = fjsp_replay_delta(&instance, r, i, j, k, lb->makespan);
+                        local_evaluations++;
+                        if (makespan < lb->makespan) {
+                            lb->makespan = makespan;
+                            lb->job = i; lb->op = j; lb->alt = k;
+                        }
                     }
-                    omp_unset_lock(&best_lock);
                 }
             }
-        }
 
-        free(local_assignment);  
-    }
-}
+            #pragma omp atomic
+            evaluations += local_evaluations;
 
-void init_instance() {
-    for (int i = 0; i < NUM_JOBS; i++) {
-        jobs[i].num_ops = MAX_OPS;
-        for (int j = 0; j < MAX_OPS; j++) {
-            jobs[i].ops[j].num_alts = NUM_MACHINES;
-            jobs[i].ops[j].alts = malloc(sizeof(Alternative) * NUM_MACHINES);
-            if (!jobs[i].ops[j].alts) {
-                printf("Erro ao alocar memória\n");
-                exit(1);
-            }
-            for (int k = 0; k < NUM_MACHINES; k++) {
-                jobs[i].ops[j].alts[k].machine = k;
-                jobs[i].ops[j].alts[k].proc_time = rand() % 10 + 1;
-            }
+            // Redução: todas as threads escolhem o mesmo melhor movimento
+            int winner = -1;
+            for (int t = 0; t < omp_get_num_threads(); t++)
+                if (local_best[t].job >= 0 && (winner < 0 || local_best[t].makespan < local_best[winner].makespan))
+                    winner = t;
+            #pragma omp barrier
+            if (winner < 0) break;
+
+            LocalBest move = local_best[winner];
+            fjsp_replay_apply(&instance, r, move.job, move.op, move.alt);
+            #pragma omp barrier
         }
-    }
-}
 
-void free_instance() {
-    for (int i = 0; i < NUM_JOBS; i++) {
-        for (int j = 0; j < MAX_OPS; j++) {
-            free(jobs[i].ops[j].alts);
+        #pragma omp master
+        {
+            best_makespan = r->makespan;
+            for (int i = 0; i < instance.num_jobs; i++)
+                for (int j = 0; j < instance.jobs[i].num_ops; j++)
+                    assignment[i][j] = r->assignment[i][j];
         }
     }
 }
 
-int main(void) {
-    clock_t start_time, end_time;
-    double cpu_time_used;
+// Instância aleatória reprodutível: a mesma semente dá a mesma instância
+// em paralelOMP.c e paralleled.c (counter_rng.h via fjsp.c).
+void init_instance(unsigned long long seed) {
+    fjsp_random_instance(&instance, NUM_JOBS, MAX_OPS, NUM_MACHINES, 10, seed);
+    for (int i = 0; i < NUM_JOBS; i++)
+        for (int j = 0; j < MAX_OPS; j++)
+            assignment[i][j] = 0;
+}
 
-    srand(time(NULL));
-    init_instance();
-    omp_init_lock(&best_lock);
+int main(int argc, char *argv[]) {
+    unsigned long long seed = argc > 1 ? strtoull(argv[1], NULL, 10) : (unsigned long long)time(NULL);
+    init_instance(seed);
+    printf("Semente = %llu\n", seed);
+    int initial = compute_makespan(assignment);
 
-    start_time = clock();
+    double start_time = omp_get_wtime();
     solve_parallel();
-    end_time = clock();
+    double elapsed = omp_get_wtime() - start_time;
 
-    cpu_time_used = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+    if (compute_makespan(assignment) != best_makespan) {
+        fprintf(stderr, "Erro: avaliação incremental diverge da completa\n");
+        return 1;
+    }
 
+    printf("Makespan inicial = %d\n", initial);
     printf("Melhor makespan encontrado = %d\n", best_makespan);
-    printf("Tempo de execução: %f segundos\n", cpu_time_used);
-
-    free_instance();
-    omp_destroy_lock(&best_lock);
-
+    printf("Avaliações: %llu\n", evaluations);
+    printf("Tempo de execução: %f segundos\n", elapsed);
     return 0;
 }
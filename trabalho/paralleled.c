@@ -1,127 +1,157 @@
+/*
+    Flexible Job-Shop com pthreads: pesquisa de reatribuições de uma alternativa
+
+    # gcc -Wall -O2 -pthread paralleled.c fjsp.c ../worker_pool.c -o paralleled
+    # ./paralleled [semente]
+
+    Mesma descida que paralelOMP.c, mas sobre o worker pool persistente
+    (../worker_pool.c): as threads são criadas uma vez e cada varrimento é um
+    pool_parallel_for() sobre os jobs, distribuídos dinamicamente (em vez de
+    i += NUM_THREADS). O FjspReplay é partilhado só para leitura durante o
+    varrimento; cada worker guarda o seu melhor movimento e a thread principal
+    aplica o melhor depois do pool_wait().
+*/
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <pthread.h>
 #include <time.h>
+#include "fjsp.h"
+#include "../worker_pool.h"
 
-#define NUM_JOBS 3
-#define MAX_OPS  3
-#define NUM_MACHINES 3
-#define NUM_THREADS 4  // Definir o número de threads
+#ifndef NUM_JOBS
+#define NUM_JOBS 100
+#endif
+#define MAX_OPS  100
+#define NUM_MACHINES 10
+#define NUM_THREADS 6  // Definir o número de threads
+#define MAX_SWEEPS 50  // limite de varrimentos da descida
 
-typedef struct {
-    int machine;
-    int proc_time;
-} Alternative;
+FjspInstance instance;
+int assignment[FJSP_MAX_JOBS][FJSP_MAX_OPS];
+int best_makespan = INT_MAX;
+FjspReplay replay;             // estado partilhado, só lido durante um varrimento
+static WorkerPool pool;
 
+// Melhor movimento de cada worker, numa linha de cache própria
 typedef struct {
-    Alternative *alts;
-    int num_alts;
-} Operation;
+    _Alignas(64) int makespan;
+    int job, op, alt;
+    unsigned long long evaluations;
+} LocalBest;
+LocalBest local_best[POOL_MAX_WORKERS + 1];   // + 1: a thread principal também ajuda
 
-typedef struct {
-    Operation ops[MAX_OPS];
-    int num_ops;
-} Job;
-
-Job jobs[NUM_JOBS];
-int best_makespan = __INT_MAX__;
-pthread_mutex_t best_mutex = PTHREAD_MUTEX_INITIALIZER;
+// Avaliação completa (referência): repete todos os jobs pela ordem.
+int compute_makespan(int assign[FJSP_MAX_JOBS][FJSP_MAX_OPS]) {
+    int machine_avail[FJSP_MAX_MACHINES] = {0};
+    int makespan = 0;
 
-typedef struct {
-    int thread_id;
-} ThreadArg;
-
-int compute_makespan(int assignment[NUM_JOBS][MAX_OPS]) {
-    int machine_avail[NUM_MACHINES] = {0};
-    int job_finish[NUM_JOBS] = {0};
-    
-    for (int j = 0; j < NUM_JOBS; j++) {
+    for (int j = 0; j < instance.num_jobs; j++) {
         int time = 0;
-        for (int o = 0; o < jobs[j].num_ops; o++) {
-            Alternative alt = jobs[j].ops[o].alts[assignment[j][o]];
-            int start = time;
-            if (machine_avail[alt.machine] > start)
-                start = machine_avail[alt.machine];
+        for (int o = 0; o < instance.jobs[j].num_ops; o++) {
+            Alternative alt = instance.jobs[j].ops[o].alts[assign[j][o]];
+            int start = (machine_avail[alt.machine] > time) ? machine_avail[alt.machine] : time;
             int finish = start + alt.proc_time;
             machine_avail[alt.machine] = finish;
             time = finish;
         }
-        job_finish[j] = time;
-    }
-    
-    int makespan = 0;
-    for (int j = 0; j < NUM_JOBS; j++) {
-        if (job_finish[j] > makespan)
-            makespan = job_finish[j];
+        if (time > makespan) makespan = time;
     }
     return makespan;
 }
 
-void *thread_func(void *arg) {
-    ThreadArg *targ = (ThreadArg*) arg;
-    int local_best_makespan = __INT_MAX__;
-    int local_assignment[NUM_JOBS][MAX_OPS];
-
-    for (int i = targ->thread_id; i < NUM_JOBS; i += NUM_THREADS) {
-        for (int j = 0; j < jobs[i].num_ops; j++) {
-            for (int k = 0; k < jobs[i].ops[j].num_alts; k++) {
-                local_assignment[i][j] = k;
-                int makespan = compute_makespan(local_assignment);
-                if (makespan < local_best_makespan) {
-                    local_best_makespan = makespan;
+// Tarefa do pool: avalia todas as mudanças de alternativa dos jobs [begin, end)
+void evaluate_jobs(void *ctx, int begin, int end, int worker) {
+    (void)ctx;
+    LocalBest *lb = &local_best[worker];
+    for (int i = begin; i < end; i++) {
+        for (int j = 0; j < instance.jobs[i].num_ops; j++) {
+            for (int k = 0; k < instance.jobs[i].ops[j].num_alts; k++) {
+                if (k == replay.assignment[i][j]) continue;
+                int makespan = fjsp_replay_delta(&instance, &replay, i, j, k, lb->makespan);
+                lb->evaluations++;
+                if (makespan < lb->makespan) {
+                    lb->makespan = makespan;
+                    lb->job = i; lb->op = j; lb->alt = k;
                 }
             }
         }
     }
-    
-    pthread_mutex_lock(&best_mutex);
-    if (local_best_makespan < best_makespan) {
-        best_makespan = local_best_makespan;
-    }
-    pthread_mutex_unlock(&best_mutex);
-    
-    free(targ);
-    return NULL;
 }
 
-void init_instance() {
-    for (int i = 0; i < NUM_JOBS; i++) {
-        jobs[i].num_ops = MAX_OPS;
-        for (int j = 0; j < MAX_OPS; j++) {
-            jobs[i].ops[j].num_alts = NUM_MACHINES;
-            jobs[i].ops[j].alts = malloc(sizeof(Alternative) * NUM_MACHINES);
-            for (int k = 0; k < NUM_MACHINES; k++) {
-                jobs[i].ops[j].alts[k].machine = k;
-                jobs[i].ops[j].alts[k].proc_time = rand() % 10 + 1;
-            }
+unsigned long long solve_parallel() {
+    unsigned long long evaluations = 0;
+    fjsp_replay_init(&instance, &replay, assignment);
+
+    for (int sweep = 0; sweep < MAX_SWEEPS; sweep++) {
+        for (int w = 0; w <= pool.num_workers; w++) {
+            local_best[w].makespan = replay.makespan;
+            local_best[w].job = -1;
+            local_best[w].evaluations = 0;
         }
+
+        pool_parallel_for(&pool, instance.num_jobs, 1, evaluate_jobs, NULL);
+
+        // Redução depois da barreira: sem lock por avaliação
+        int winner = -1;
+        for (int w = 0; w <= pool.num_workers; w++) {
+            evaluations += local_best[w].evaluations;
+            if (local_best[w].job >= 0 && (winner < 0 || local_best[w].makespan < local_best[winner].makespan))
+                winner = w;
+        }
+        if (winner < 0) break;
+        fjsp_replay_apply(&instance, &replay, local_best[winner].job, local_best[winner].op, local_best[winner].alt);
     }
+
+    best_makespan = replay.makespan;
+    for (int i = 0; i < instance.num_jobs; i++)
+        for (int j = 0; j < instance.jobs[i].num_ops; j++)
+            assignment[i][j] = replay.assignment[i][j];
+    return evaluations;
 }
 
-int main(void) {
-    clock_t start_time, end_time;
-    double cpu_time_used;
-    
-    init_instance();
-    
-    start_time = clock();
-    
-    pthread_t threads[NUM_THREADS];
-    for (int i = 0; i < NUM_THREADS; i++) {
-        ThreadArg *arg = malloc(sizeof(ThreadArg));
-        arg->thread_id = i;
-        pthread_create(&threads[i], NULL, thread_func, arg);
+// Instância aleatória reprodutível: a mesma semente dá a mesma instância
+// em paralelOMP.c e paralleled.c (counter_rng.h via fjsp.c).
+void init_instance(unsigned long long seed) {
+    fjsp_random_instance(&instance, NUM_JOBS, MAX_OPS, NUM_MACHINES, 10, seed);
+    for (int i = 0; i < NUM_JOBS; i++)
+        for (int j = 0; j < MAX_OPS; j++)
+            assignment[i][j] = 0;
+}
+
+double wall_time() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned long long seed = argc > 1 ? strtoull(argv[1], NULL, 10) : (unsigned long long)time(NULL);
+    init_instance(seed);
+    printf("Semente = %llu\n", seed);
+    int initial = compute_makespan(assignment);
+
+    if (pool_init(&pool, NUM_THREADS) != 0) {
+        fprintf(stderr, "Erro ao criar as threads\n");
+        return 1;
     }
-    
-    for (int i = 0; i < NUM_THREADS; i++) {
-        pthread_join(threads[i], NULL);
+
+    // Tempo de parede: clock() somaria o CPU de todas as threads
+    double start_time = wall_time();
+    unsigned long long evaluations = solve_parallel();
+    double elapsed = wall_time() - start_time;
+    pool_destroy(&pool);
+
+    if (compute_makespan(assignment) != best_makespan) {
+        fprintf(stderr, "Erro: avaliação incremental diverge da completa\n");
+        return 1;
     }
-    
-    end_time = clock();
-    cpu_time_used = ((double) (end_time - start_time)) / CLOCKS_PER_SEC;
-    
+
+    printf("Makespan inicial = %d\n", initial);
     printf("Melhor makespan encontrado = %d\n", best_makespan);
-    printf("Tempo de execução: %f segundos\n", cpu_time_used);
-    
+    printf("Avaliações: %llu\n", evaluations);
+    printf("Tempo de execução: %f segundos\n", elapsed);
+
     return 0;
 }
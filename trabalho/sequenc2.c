@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include "../counter_rng.h"
 
 #define NUM_JOBS 100
 #define MAX_OPS  100
@@ -77,7 +78,8 @@ void solve_sequential() {
     }
 }
 
-void init_instance() {
+// Tempos reprodutíveis: função de (semente, job, operação, máquina), ver counter_rng.h
+void init_instance(unsigned long long seed) {
     for (int i = 0; i < NUM_JOBS; i++) {
         jobs[i].num_ops = MAX_OPS;
         for (int j = 0; j < MAX_OPS; j++) {
@@ -89,7 +91,7 @@ void init_instance() {
             }
             for (int k = 0; k < NUM_MACHINES; k++) {
                 jobs[i].ops[j].alts[k].machine = k;
-                jobs[i].ops[j].alts[k].proc_time = rand() % 50 + 1;
+                jobs[i].ops[j].alts[k].proc_time = crng_range(seed, i, (uint64_t)j * NUM_MACHINES + k, 1, 50);
             }
         }
     }
@@ -103,12 +105,14 @@ void free_instance() {
     }
 }
 
-int main(void) {
+int main(int argc, char *argv[]) {
     clock_t start_time, end_time;
     double cpu_time_used;
     
-    srand(time(NULL)); // Garante aleatoriedade nos tempos de processamento
-    init_instance();
+    // Semente opcional; por omissão o relógio garante aleatoriedade nos tempos de processamento
+    unsigned long long seed = argc > 1 ? strtoull(argv[1], NULL, 10) : (unsigned long long)time(NULL);
+    init_instance(seed);
+    printf("Semente = %llu\n", seed);
     
     start_time = clock();
     solve_sequential();
@@ -0,0 +1,241 @@
+/*
+    Persistent pthread worker pool (see worker_pool.h).
+*/
+
+#include <limits.h>
+#include "worker_pool.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+// ================== Parking ==================
+
+// Sleeps while *word == expected (spurious wake-ups are fine: callers loop).
+static void park(WorkerPool *p, atomic_uint *word, unsigned expected) {
+#ifdef __linux__
+    (void)p;
+    syscall(SYS_futex, (unsigned *)word, FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+#else
+    pthread_mutex_lock(&p->park_lock);
+    while (atomic_load(word) == expected)
+        pthread_cond_wait(&p->park_cond, &p->park_lock);
+    pthread_mutex_unlock(&p->park_lock);
+#endif
+}
+
+static void unpark(WorkerPool *p, atomic_uint *word, int count) {
+#ifdef __linux__
+    (void)p;
+    syscall(SYS_futex, (unsigned *)word, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+#else
+    (void)word; (void)count;
+    pthread_mutex_lock(&p->park_lock);
+    pthread_cond_broadcast(&p->park_cond);
+    pthread_mutex_unlock(&p->park_lock);
+#endif
+}
+
+// ================== Bounded MPMC queue ==================
+
+/*
+    Cell i is free for the producer at position pos when its sequence equals
+    pos and holds a task for the consumer at pos when it equals pos + 1. The
+    positions only move by CAS, so producers and consumers never lock.
+*/
+static void queue_init(PoolQueue *q) {
+    for (size_t i = 0; i < POOL_QUEUE_SIZE; i++)
+        atomic_store_explicit(&q->cells[i].sequence, i, memory_order_relaxed);
+    atomic_store(&q->enqueue_pos, 0);
+    atomic_store(&q->dequeue_pos, 0);
+}
+
+static int queue_push(PoolQueue *q, PoolTaskFn fn, void *arg) {
+    size_t pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+    for (;;) {
+        PoolCell *cell = &q->cells[pos & (POOL_QUEUE_SIZE - 1)];
+        size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        long diff = (long)(seq - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                cell->fn = fn;
+                cell->arg = arg;
+                atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;   // full
+        } else {
+            pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+static int queue_pop(PoolQueue *q, PoolTaskFn *fn, void **arg) {
+    size_t pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+    for (;;) {
+        PoolCell *cell = &q->cells[pos & (POOL_QUEUE_SIZE - 1)];
+        size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        long diff = (long)(seq - (pos + 1));
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->dequeue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                *fn = cell->fn;
+                *arg = cell->arg;
+                atomic_store_explicit(&cell->sequence, pos + POOL_QUEUE_SIZE, memory_order_release);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;   // empty
+        } else {
+            pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+// ================== Workers ==================
+
+// Pool and index of the calling thread when it is one of the workers, so a
+// task that submits or waits on its own pool helps under its own index.
+static _Thread_local WorkerPool *own_pool = NULL;
+static _Thread_local int own_index = 0;
+
+static int caller_index(WorkerPool *p) {
+    return own_pool == p ? own_index : p->num_workers;
+}
+
+// Pops and runs one task. Returns 0 if the queue was empty.
+static int run_one(WorkerPool *p, int worker) {
+    PoolTaskFn fn;
+    void *arg;
+    if (!queue_pop(&p->queue, &fn, &arg)) return 0;
+    fn(arg, worker);
+    if (atomic_fetch_sub(&p->pending, 1) == 1) {
+        atomic_fetch_add(&p->done_seq, 1);
+        unpark(p, &p->done_seq, INT_MAX);
+    }
+    return 1;
+}
+
+static void *worker_main(void *arg) {
+    WorkerPool *p = arg;
+    int worker = atomic_fetch_add(&p->next_index, 1);
+    own_pool = p;
+    own_index = worker;
+    if (p->on_start) p->on_start(p->start_arg, worker);
+
+    for (;;) {
+        int spins = 0;
+        while (spins < POOL_SPIN) {
+            if (run_one(p, worker)) spins = 0;
+            else spins++;
+        }
+
+        // Announce the intent to sleep, then look once more: a submitter
+        // either sees the sleeper and wakes it or its task is found here.
+        unsigned seq = atomic_load(&p->work_seq);
+        atomic_fetch_add(&p->sleepers, 1);
+        if (run_one(p, worker)) {
+            atomic_fetch_sub(&p->sleepers, 1);
+            continue;
+        }
+        if (atomic_load(&p->shutdown)) {
+            atomic_fetch_sub(&p->sleepers, 1);
+            break;
+        }
+        park(p, &p->work_seq, seq);
+        atomic_fetch_sub(&p->sleepers, 1);
+    }
+    return NULL;
+}
+
+// ================== API ==================
+
+int pool_init(WorkerPool *p, int num_workers) {
+    return pool_init_with_start(p, num_workers, NULL, NULL);
+}
+
+int pool_init_with_start(WorkerPool *p, int num_workers, PoolTaskFn on_start, void *start_arg) {
+    if (num_workers < 1) num_workers = 1;
+    if (num_workers > POOL_MAX_WORKERS) num_workers = POOL_MAX_WORKERS;
+
+    queue_init(&p->queue);
+    atomic_store(&p->pending, 0);
+    atomic_store(&p->work_seq, 0);
+    atomic_store(&p->sleepers, 0);
+    atomic_store(&p->done_seq, 0);
+    atomic_store(&p->shutdown, 0);
+    atomic_store(&p->next_index, 0);
+    p->on_start = on_start;
+    p->start_arg = start_arg;
+#ifndef __linux__
+    pthread_mutex_init(&p->park_lock, NULL);
+    pthread_cond_init(&p->park_cond, NULL);
+#endif
+
+    p->num_workers = 0;
+    for (int w = 0; w < num_workers; w++) {
+        if (pthread_create(&p->threads[w], NULL, worker_main, p) != 0) {
+            pool_destroy(p);
+            return -1;
+        }
+        p->num_workers++;
+    }
+    return 0;
+}
+
+void pool_submit(WorkerPool *p, PoolTaskFn fn, void *arg) {
+    atomic_fetch_add(&p->pending, 1);
+    while (!queue_push(&p->queue, fn, arg))
+        run_one(p, caller_index(p));   // full: make room by working
+    atomic_fetch_add(&p->work_seq, 1);
+    if (atomic_load(&p->sleepers) > 0) unpark(p, &p->work_seq, 1);
+}
+
+void pool_wait(WorkerPool *p) {
+    for (;;) {
+        if (run_one(p, caller_index(p))) continue;
+        unsigned seq = atomic_load(&p->done_seq);
+        if (atomic_load(&p->pending) == 0) return;
+        park(p, &p->done_seq, seq);
+    }
+}
+
+typedef struct {
+    PoolRangeFn fn;
+    void *ctx;
+    int n, chunk;
+    _Alignas(64) atomic_int next;
+} RangeJob;
+
+static void range_task(void *arg, int worker) {
+    RangeJob *job = arg;
+    for (;;) {
+        int begin = atomic_fetch_add_explicit(&job->next, job->chunk, memory_order_relaxed);
+        if (begin >= job->n) return;
+        int end = begin + job->chunk < job->n ? begin + job->chunk : job->n;
+        job->fn(job->ctx, begin, end, worker);
+    }
+}
+
+// One task per worker; each keeps claiming chunks until the range is exhausted.
+void pool_parallel_for(WorkerPool *p, int n, int chunk, PoolRangeFn fn, void *ctx) {
+    RangeJob job = { fn, ctx, n, chunk > 0 ? chunk : 1, 0 };
+    for (int w = 0; w < p->num_workers; w++) pool_submit(p, range_task, &job);
+    pool_wait(p);
+}
+
+void pool_destroy(WorkerPool *p) {
+    atomic_store(&p->shutdown, 1);
+    atomic_fetch_add(&p->work_seq, 1);
+    unpark(p, &p->work_seq, INT_MAX);
+    for (int w = 0; w < p->num_workers; w++) pthread_join(p->threads[w], NULL);
+    p->num_workers = 0;
+#ifndef __linux__
+    pthread_mutex_destroy(&p->park_lock);
+    pthread_cond_destroy(&p->park_cond);
+#endif
+}
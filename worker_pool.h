@@ -0,0 +1,83 @@
+/*
+    Persistent pthread worker pool.
+
+    Workers are created once by pool_init() and reused for every batch of
+    tasks, so solvers pay no thread creation cost per run. Tasks are
+    {function, argument} pairs in a bounded lock-free MPMC queue (Vyukov's
+    sequence-numbered ring); any thread may submit. Idle workers spin
+    briefly and then park on a futex (Linux; a mutex/condition pair
+    elsewhere), so an idle pool costs no CPU.
+
+    - pool_submit():       enqueue one task (the caller runs tasks itself
+                           while the queue is full)
+    - pool_wait():         barrier; returns when every submitted task has
+                           finished, running queued tasks while it waits
+    - pool_parallel_for(): [0, n) in chunks handed out by an atomic counter
+                           (dynamic load balancing), then pool_wait()
+
+    pool_init_with_start() runs a start function on every worker thread
+    before it takes tasks (thread pinning, first-touch of per-worker data).
+
+    Task functions receive a worker index in [0, num_workers]: workers use
+    0..num_workers-1 and the submitting thread, when it helps, uses
+    num_workers (a worker submitting from inside a task helps under its own
+    index). Per-worker scratch arrays therefore need num_workers + 1
+    entries (POOL_MAX_WORKERS + 1 at most).
+
+    One thread drives a pool at a time (submit/wait/destroy); tasks may
+    submit more tasks but must not call pool_wait().
+*/
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#define POOL_MAX_WORKERS 64
+#define POOL_QUEUE_SIZE  4096   // tasks, power of two
+#define POOL_SPIN        256    // empty polls before a worker parks
+
+typedef void (*PoolTaskFn)(void *arg, int worker);
+typedef void (*PoolRangeFn)(void *ctx, int begin, int end, int worker);
+
+typedef struct {
+    _Atomic size_t sequence;
+    PoolTaskFn fn;
+    void *arg;
+} PoolCell;
+
+typedef struct {
+    _Alignas(64) _Atomic size_t enqueue_pos;
+    _Alignas(64) _Atomic size_t dequeue_pos;
+    _Alignas(64) PoolCell cells[POOL_QUEUE_SIZE];
+} PoolQueue;
+
+typedef struct {
+    PoolQueue queue;
+    _Alignas(64) atomic_int pending;      // submitted and not yet finished
+    _Alignas(64) atomic_uint work_seq;    // futex word: bumped on submit
+    atomic_int sleepers;                  // workers parked or about to park
+    _Alignas(64) atomic_uint done_seq;    // futex word: bumped when pending hits 0
+    atomic_int shutdown;
+    atomic_int next_index;                // hands out worker indices at start-up
+    PoolTaskFn on_start;                  // optional, run once per worker
+    void *start_arg;
+    int num_workers;
+    pthread_t threads[POOL_MAX_WORKERS];
+#ifndef __linux__
+    pthread_mutex_t park_lock;
+    pthread_cond_t park_cond;
+#endif
+} WorkerPool;
+
+// Large (queue of POOL_QUEUE_SIZE cells): declare pools static.
+int  pool_init(WorkerPool *p, int num_workers);
+int  pool_init_with_start(WorkerPool *p, int num_workers, PoolTaskFn on_start, void *start_arg);
+void pool_submit(WorkerPool *p, PoolTaskFn fn, void *arg);
+void pool_wait(WorkerPool *p);
+void pool_parallel_for(WorkerPool *p, int n, int chunk, PoolRangeFn fn, void *ctx);
+void pool_destroy(WorkerPool *p);
+
+#endif